@@ -0,0 +1,158 @@
+/**
+ * @file FFT_frame_arena.h
+ * @brief Preallocated frame storage for FFT_Initiator
+ *
+ * The per-frame buffers (input, reference, output) of all frames in flight live in one
+ * contiguous, 64-byte aligned allocation organised as a ring of frame slots. Frame f
+ * uses slot f % slots; storing into a slot for a new frame retires the frame that held
+ * it, so memory stays constant however many frames are run.
+ */
+
+#ifndef FFT_FRAME_ARENA_H
+#define FFT_FRAME_ARENA_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+
+#include "FFT_initiator_utils.h"
+
+namespace FFTInitiatorUtils {
+
+constexpr size_t FRAME_ARENA_ALIGN = 64;   // bytes, one cache line / AXI burst
+
+// Allocator for over-aligned vectors
+template <typename T, size_t Align = FRAME_ARENA_ALIGN>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Align>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Align>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Align)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(Align));
+    }
+    template <typename U> bool operator==(const AlignedAllocator<U, Align>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Align>&) const { return false; }
+};
+
+template <typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T>>;
+
+// One frame buffer: size valid points at data
+template <typename T>
+struct FrameSpan {
+    T* data = nullptr;
+    size_t size = 0;
+
+    T* begin() const { return data; }
+    T* end() const { return data + size; }
+    T& operator[](size_t i) const { return data[i]; }
+    bool empty() const { return size == 0; }
+    std::vector<T> to_vector() const { return std::vector<T>(begin(), end()); }
+};
+
+enum FrameBuffer { FRAME_INPUT, FRAME_REFERENCE, FRAME_OUTPUT, FRAME_BUFFER_COUNT };
+
+template <typename T>
+class FrameArena {
+public:
+    static constexpr unsigned NO_FRAME = ~0u;
+
+    // Allocates slots x FRAME_BUFFER_COUNT buffers of frame_len points, each starting on a
+    // FRAME_ARENA_ALIGN boundary. All slots start empty.
+    void reset(size_t frame_len, unsigned slots) {
+        const size_t per_line = FRAME_ARENA_ALIGN / sizeof(complex<T>);
+        frame_len_ = frame_len;
+        stride_ = (frame_len + per_line - 1) / per_line * per_line;
+        slots_ = slots;
+        storage_.assign(stride_ * FRAME_BUFFER_COUNT * slots, complex<T>(0, 0));
+        slot_frame_.assign(slots, NO_FRAME);
+        lengths_.assign(slots * FRAME_BUFFER_COUNT, 0);
+    }
+
+    unsigned slots() const { return slots_; }
+    size_t frame_len() const { return frame_len_; }
+    size_t bytes() const { return storage_.size() * sizeof(complex<T>); }
+
+    // Frame still held by its slot (not yet retired by a newer frame)
+    bool resident(unsigned frame_id) const {
+        return slots_ != 0 && slot_frame_[frame_id % slots_] == frame_id;
+    }
+
+    // Claims the slot of frame_id; a different frame holding it is retired and all buffers restart empty
+    void acquire(unsigned frame_id) {
+        unsigned slot = frame_id % slots_;
+        if (slot_frame_[slot] != frame_id) {
+            slot_frame_[slot] = frame_id;
+            for (unsigned b = 0; b < FRAME_BUFFER_COUNT; b++) {
+                lengths_[slot * FRAME_BUFFER_COUNT + b] = 0;
+            }
+        }
+    }
+
+    // Buffer contents; empty if the frame was never stored or has been retired
+    FrameSpan<complex<T>> get(unsigned frame_id, FrameBuffer b) {
+        if (!resident(frame_id)) {
+            return FrameSpan<complex<T>>();
+        }
+        unsigned slot = frame_id % slots_;
+        return FrameSpan<complex<T>>{buffer(slot, b), lengths_[slot * FRAME_BUFFER_COUNT + b]};
+    }
+
+    // Sets the valid length (<= frame_len) and returns the buffer for writing, claiming the slot
+    FrameSpan<complex<T>> resize(unsigned frame_id, FrameBuffer b, size_t n) {
+        acquire(frame_id);
+        unsigned slot = frame_id % slots_;
+        if (n > frame_len_) {
+            std::cout << "ERROR: frame " << frame_id << " buffer of " << n << " points exceeds arena frame length "
+                      << frame_len_ << ", truncated" << std::endl;
+            n = frame_len_;
+        }
+        lengths_[slot * FRAME_BUFFER_COUNT + b] = n;
+        return FrameSpan<complex<T>>{buffer(slot, b), n};
+    }
+
+    template <typename U>
+    FrameSpan<complex<T>> store(unsigned frame_id, FrameBuffer b, const complex<U>* data, size_t n) {
+        FrameSpan<complex<T>> span = resize(frame_id, b, n);
+        for (size_t i = 0; i < span.size; i++) {
+            span[i] = complex<T>(data[i].real, data[i].imag);
+        }
+        return span;
+    }
+
+    template <typename U>
+    FrameSpan<complex<T>> store(unsigned frame_id, FrameBuffer b, const std::vector<complex<U>>& data) {
+        return store(frame_id, b, data.data(), data.size());
+    }
+
+    // rows x cols row-major view of a buffer, e.g. the N2 x N1 matrix of a 2D decomposition
+    MatrixView<complex<T>> matrix(unsigned frame_id, FrameBuffer b, size_t rows, size_t cols) {
+        FrameSpan<complex<T>> span = get(frame_id, b);
+        if (rows * cols > span.size) {
+            return MatrixView<complex<T>>();
+        }
+        return matrix_view(span.data, rows, cols);
+    }
+
+private:
+    complex<T>* buffer(unsigned slot, FrameBuffer b) {
+        return storage_.data() + (static_cast<size_t>(slot) * FRAME_BUFFER_COUNT + b) * stride_;
+    }
+
+    size_t frame_len_ = 0;
+    size_t stride_ = 0;            // frame_len rounded up to a whole number of alignment lines
+    unsigned slots_ = 0;
+    aligned_vector<complex<T>> storage_;
+    std::vector<unsigned> slot_frame_;   // frame held by each slot, NO_FRAME if none
+    std::vector<size_t> lengths_;        // valid points per slot and buffer
+};
+
+} // namespace FFTInitiatorUtils
+
+#endif // FFT_FRAME_ARENA_H
@@ -10,6 +10,7 @@
 #include "util/tools.h"
 #include "FFT_initiator_utils.h"
 #include <cmath>
+#include <numeric>
 
 using namespace std;
 using namespace FFTTestUtils;
@@ -58,10 +59,72 @@ void FFT_Initiator<T>::configure_test_parameters() {
     
     decomposition_level = decomp_info.level;
     use_2d_decomposition = (decomposition_level > 0);
+    // 实数输入模式：两帧实数打包成一次复数FFT，或单帧做N/2点复数FFT加后处理
+    real_input_mode = fft_test_modes().real_input;
+    real_pack_two_frames = true;
+    if (real_input_mode && TEST_FFT_SIZE % 2 != 0) {
+        cout << "  WARNING: Real mode needs an even FFT size, falling back to complex frames" << endl;
+        real_input_mode = false;
+    }
+    
+    // 快速卷积模式：每帧作为信号经 FFT -> 乘滤波器频谱 -> IFFT 做重叠保留滤波
+    fast_convolution_mode = fft_test_modes().fast_convolution;
+    conv_filter_len = 8;
+    conv_block_size = FFT_TLM_N;
+    while (conv_block_size < 2 * conv_filter_len) conv_block_size <<= 1;
+    
+    // 数据+旋转因子放不下AM时，数据留在DDR，按面板流经AM
+    use_out_of_core = !FFTInitiatorUtils::frame_fits_am(TEST_FFT_SIZE, AM_SIZE);
+    if (use_out_of_core &&
+        !FFTInitiatorUtils::make_six_step_layout(TEST_FFT_SIZE, AM_SIZE / sizeof(complex<float>)).is_valid) {
+        cout << "  ERROR: No six-step layout for " << TEST_FFT_SIZE
+             << " points in " << AM_SIZE << " bytes of AM" << endl;
+        assert(false && "FFT size exceeds AM and has no six-step layout");
+    }
     
     cout << "  - Target FFT size: " << TEST_FFT_SIZE << " points" << endl;
     cout << "  - Hardware base size (FFT_TLM_N): " << FFT_TLM_N << endl;
     cout << "  - Decomposition level: " << decomposition_level << endl;
+    if (decomp_info.bluestein_size != 0) {
+        cout << "  - Bluestein: " << TEST_FFT_SIZE << " points via " << decomp_info.bluestein_size
+             << "-point convolution (not a product of hardware leaf sizes)" << endl;
+    } else if (!decomp_info.level_dims.empty() &&
+               std::gcd(decomp_info.level_dims[0].first, decomp_info.level_dims[0].second) == 1) {
+        cout << "  - Prime factor (Good-Thomas): " << decomp_info.level_dims[0].first << "-point leaf × "
+             << decomp_info.level_dims[0].second << "-point sub-plan, no twiddle pass" << endl;
+    }
+    // 跨帧流水：AM中放得下至少两帧时，搬入/计算/写回三级并行
+    pipelined_frames = fft_test_modes().pipelined_frames;
+    pipeline_am_slots = static_cast<unsigned>(std::min<uint64_t>(FRAME_PIPELINE_AM_SLOTS, 
+                                                                 AM_SIZE / (2 * TEST_FFT_SIZE * sizeof(complex<T>))));
+    if (pipelined_frames && (pipeline_am_slots < 2 || use_out_of_core || real_input_mode || fast_convolution_mode)) {
+        cout << "  WARNING: Frame pipeline needs two AM frame slots and the plain complex mode, running sequentially" << endl;
+        pipelined_frames = false;
+    }
+    if (pipelined_frames) {
+        cout << "  - Cross-frame pipeline: " << pipeline_am_slots << " AM frame slots" << endl;
+    }
+    frames_drained = 0;
+    
+    // 帧缓冲：一次性分配的连续环形帧槽，只保留在途的帧，内存与帧数无关。
+    // 顺序模式最多同时持有两帧（实数模式两帧打包），流水模式在途帧数受AM槽数限制
+    frame_arena.reset(TEST_FFT_SIZE, pipelined_frames ? FRAME_ARENA_SLOTS : 2);
+    total_frames_tested = 0;
+    frames_passed = 0;
+    frames_failed = 0;
+    cout << "  - Frame arena: " << frame_arena.slots() << " slots, " 
+         << frame_arena.bytes() / 1024 << " KB" << endl;
+    if (fast_convolution_mode) {
+        cout << "  - Fast convolution: " << conv_filter_len << " taps, " 
+             << conv_block_size << "-point overlap-save blocks" << endl;
+    }
+    if (real_input_mode) {
+        cout << "  - Real input: " << TEST_FFT_SIZE / 2 + 1 << " Hermitian bins per frame, "
+             << (real_pack_two_frames ? "two frames per complex FFT" : "N/2-point complex FFT + post-twiddle") << endl;
+    }
+    if (use_out_of_core) {
+        cout << "  - Frame exceeds AM (" << AM_SIZE / 1024 << " KB): out-of-core six-step mode" << endl;
+    }
     
     if (use_2d_decomposition) {
         cout << "  - Decomposition strategy:" << endl;
@@ -98,13 +161,13 @@ template <typename T>
 void FFT_Initiator<T>::initialize_fft_hardware() {
     cout << "\n[FFT-HW] Initializing FFT hardware..." << endl;
     
-    // Step 1: 系统复位
+    // Step 1: 系统复位，复位后硬件配置失效
     cout << "  - Executing system reset..." << endl;
     send_fft_reset_transaction();
+    fft_config_valid = false;
     
     // Step 2: 配置FFT参数
-    FFTConfiguration config = FFTInitiatorUtils::create_fft_configuration(FFT_TLM_N, real_single_fft_size);
-    send_fft_configure_transaction(config);
+    configure_fft_size(real_single_fft_size);
     
 
     // Step 3: 加载旋转因子
@@ -112,7 +175,8 @@ void FFT_Initiator<T>::initialize_fft_hardware() {
     send_fft_load_twiddles_transaction();
     
     // 等待硬件初始化完成
-    wait(sc_time(2*FFT_TLM_N/2*FFT_TLM_N/2, SC_NS));
+    lt_consume(&this->qk, sc_time(2*FFT_TLM_N/2*FFT_TLM_N/2, SC_NS));
+    lt_sync(&this->qk);
 }
 
 // ============================================
@@ -124,7 +188,13 @@ void FFT_Initiator<T>::FFT_frame_loop_process() {
     cout << "\n====== FFT Multi-Frame Processing Started ======" << endl;
     wait(FFT_init_process_done_event);
     
-    for (unsigned frame = 0; frame < test_frames_count; frame++) {
+    // 流水模式下由三个流水级进程处理全部帧
+    if (pipelined_frames) {
+        frame_pipeline_start_event.notify(SC_ZERO_TIME);
+        wait(frame_pipeline_done_event);
+    }
+    
+    for (unsigned frame = 0; frame < test_frames_count && !pipelined_frames; frame++) {
         current_frame_id = frame;
         
         cout << "\n========== FRAME " << frame + 1 << "/" << test_frames_count 
@@ -133,21 +203,133 @@ void FFT_Initiator<T>::FFT_frame_loop_process() {
         reset_frame_state();
         
         // 根据分解层级选择处理模式
-        if (decomposition_level == 0) {
+        if (fast_convolution_mode) {
+            process_frame_convolution_mode();
+        } else if (real_input_mode) {
+            // 两帧打包时下一帧已在本次处理
+            if (process_frame_real_mode()) {
+                frame++;
+            }
+        } else if (use_out_of_core) {
+            process_frame_six_step_mode();
+        } else if (decomposition_level == 0) {
             process_frame_direct_mode();
         } else if (decomposition_level == 1) {
             process_frame_level1_mode();
-        } else if (decomposition_level == 2) {
+        } else if (decomposition_level >= 2) {
+            // Level 2及更深的递归分解都由缓存的FFT计划执行
             process_frame_level2_mode();
         }
 
     }
     
+    // LT模式下把剩余的本地时间同步回仿真内核，保证总仿真时间完整
+    lt_sync(&this->qk);
     cout << "\n====== All Frames Processing Completed ======" << endl;
     display_final_statistics();
     sc_stop();
 }
 
+// ============================================
+// 跨帧流水：搬入帧N+1 / 计算帧N / 写回帧N-1
+// ============================================
+
+template <typename T>
+uint64_t FFT_Initiator<T>::pipeline_slot_address(unsigned slot) const {
+    // 每个槽为帧数据加同样大小的转角缓冲
+    return AM_BASE_ADDR + static_cast<uint64_t>(slot) * 2 * TEST_FFT_SIZE * sizeof(complex<T>);
+}
+
+template <typename T>
+void FFT_Initiator<T>::FFT_frame_load_process() {
+    wait(frame_pipeline_start_event);
+    load_qk.reset();
+    
+    const size_t n = TEST_FFT_SIZE;
+    const uint64_t frame_bytes = n * sizeof(complex<T>);
+    for (unsigned slot = 0; slot < pipeline_am_slots; slot++) {
+        free_am_slots.write(slot);
+    }
+    
+    for (unsigned frame = 0; frame < test_frames_count; frame++) {
+        // 等待空闲AM槽，槽数限定了在途帧数
+        unsigned slot = free_am_slots.read();
+        
+        // 生成数据和参考结果之间没有wait，current_frame_id不会被其他流水级改写
+        current_frame_id = frame;
+        auto test_data = generate_frame_test_data();
+        compute_reference_results(test_data);
+        frame_arena.store(frame, FFTInitiatorUtils::FRAME_INPUT, test_data);
+        
+        uint64_t ddr_addr = FFTInitiatorUtils::calculate_ddr_address(frame, n, DDR_BASE_ADDR);
+        write_data_to_ddr(test_data, ddr_addr);
+        ins::dma_nb_handle handle;
+        ins::dma_p2p_trans_nb(this->socket, handle,
+                              ddr_addr, 0, frame_bytes, 1,
+                              pipeline_slot_address(slot), 0, frame_bytes, 1, 0, &load_qk);
+        ins::dma_nb_wait(handle);
+        
+        lt_sync(&load_qk);
+        cout << "[PIPE-LOAD] Frame " << frame + 1 << " -> AM slot " << slot << " @ " << sc_time_stamp() << endl;
+        load_to_compute_fifo.write(FramePipelineToken{frame, slot, pipeline_slot_address(slot)});
+    }
+}
+
+template <typename T>
+void FFT_Initiator<T>::FFT_frame_compute_process() {
+    while (true) {
+        FramePipelineToken token = load_to_compute_fifo.read();
+        
+        // 直接在AM槽内执行计划，结果可能落在槽的转角缓冲中
+        auto& plan = get_fft_plan(TEST_FFT_SIZE);
+        uint64_t slot_addr = pipeline_slot_address(token.slot);
+        token.result_addr = execute_corner_turn_fft(plan, slot_addr, slot_addr + TEST_FFT_SIZE * sizeof(complex<T>));
+        
+        lt_sync(&this->qk);
+        cout << "[PIPE-COMP] Frame " << token.frame_id + 1 << " computed @ " << sc_time_stamp() << endl;
+        compute_to_drain_fifo.write(token);
+    }
+}
+
+template <typename T>
+void FFT_Initiator<T>::FFT_frame_drain_process() {
+    drain_qk.reset();
+    const size_t n = TEST_FFT_SIZE;
+    const uint64_t frame_bytes = n * sizeof(complex<T>);
+    
+    while (true) {
+        FramePipelineToken token = compute_to_drain_fifo.read();
+        
+        // 结果写回DDR中该帧数据区之后，写回完成即释放AM槽
+        uint64_t ddr_out_addr = FFTInitiatorUtils::calculate_ddr_address(token.frame_id, n, DDR_BASE_ADDR) + frame_bytes;
+        ins::dma_nb_handle handle;
+        ins::dma_p2p_trans_nb(this->socket, handle,
+                              token.result_addr, 0, frame_bytes, 1,
+                              ddr_out_addr, 0, frame_bytes, 1, 1, &drain_qk);
+        ins::dma_nb_wait(handle);
+        lt_sync(&drain_qk);
+        free_am_slots.write(token.slot);
+        
+        vector<complex<T>> result;
+        ins::read_from_dmi_bulk<complex<T>>(ddr_out_addr, result, this->ddr_dmi, n, "FFT_Initiator", &drain_qk);
+        lt_sync(&drain_qk);
+        
+        current_frame_id = token.frame_id;
+        frame_arena.store(token.frame_id, FFTInitiatorUtils::FRAME_OUTPUT, result);
+        perform_final_verification();
+        
+        if (frames_drained == 0) {
+            first_frame_done_time = sc_time_stamp();
+        }
+        last_frame_done_time = sc_time_stamp();
+        frames_drained++;
+        cout << "[PIPE-DRAIN] Frame " << token.frame_id + 1 << " done @ " << sc_time_stamp() << endl;
+        if (frames_drained == test_frames_count) {
+            frame_pipeline_done_event.notify();
+        }
+    }
+}
+
 // ============================================
 // Level 1处理模式（单层2D分解）
 // ============================================
@@ -156,41 +338,18 @@ template <typename T>
 void FFT_Initiator<T>::process_frame_level1_mode() {
     cout << "[FRAME-L1] Using Level 1 (single 2D decomposition) mode" << endl;
     
-    // 首先获取Level 1的分解维度（在准备数据之前）
-    auto decomp_info = FFTInitiatorUtils::analyze_decomposition_strategy(TEST_FFT_SIZE, FFT_TLM_N);
-    N1 = decomp_info.level_dims[0].first;
-    N2 = decomp_info.level_dims[0].second;
+    // 分解维度取自按点数缓存的FFT计划，只在第一帧分析一次
+    auto& plan = get_fft_plan(TEST_FFT_SIZE);
+    N1 = plan.root()->n1;
+    N2 = plan.root()->n2;
     
     cout << "  Level 1 decomposition: " << N1 << " × " << N2 << endl;
     
     // 现在准备数据（N1和N2已经正确设置）
     prepare_frame_data_once();
     
-    // 执行Level 1的2D处理
-    execute_level1_2d_fft();
-}
-
-template <typename T>
-void FFT_Initiator<T>::execute_level1_2d_fft() {
-    cout << "\n[L1-2D] Starting Level 1 2D decomposition..." << endl;
-    
-    // 初始化矩阵
-    initialize_2d_matrices();
-    
-    // 将输入数据重排为矩阵
-    vector<complex<T>> input_data = frame_input_data[current_frame_id];
-    frame_data_matrix[current_frame_id] = FFTInitiatorUtils::reshape_to_matrix(input_data, N2, N1);
-    
-    // Stage 1: 列FFT
-    process_level1_column_fft();
-    // Stage 2: 旋转因子
-    process_level1_twiddle();
-    // Stage 3: 行FFT
-    process_level1_row_fft();
-    
-    // 整理结果
-    finalize_2d_results();
-    perform_final_verification();
+    // 执行Level 1计划
+    execute_planned_fft(plan);
 }
 
 // ============================================
@@ -199,109 +358,39 @@ void FFT_Initiator<T>::execute_level1_2d_fft() {
 
 template <typename T>
 void FFT_Initiator<T>::process_frame_level2_mode() {
-    cout << "[FRAME-L2] Using Level 2 (nested 2D decomposition) mode" << endl;
+    cout << "[FRAME-L2] Using Level " << decomposition_level << " (nested 2D decomposition) mode" << endl;
     
     // 准备数据
     prepare_frame_data_once();
     
-    // 获取分解维度
-    auto decomp_info = FFTInitiatorUtils::analyze_decomposition_strategy(TEST_FFT_SIZE, FFT_TLM_N);
-    size_t L2_N1 = decomp_info.level_dims[0].first;  // Level 2维度
-    size_t L2_N2 = decomp_info.level_dims[0].second;
+    // 获取缓存的计划（Level 2维度及其子分解）
+    auto& plan = get_fft_plan(TEST_FFT_SIZE);
     
-    cout << "  Level 2 decomposition: " << L2_N1 << " × " << L2_N2 << endl;
+    cout << "  Top level decomposition: " << plan.root()->n1 << " × " << plan.root()->n2 << endl;
     
-    // 执行Level 2的2D处理
-    execute_level2_2d_fft(L2_N1, L2_N2);
+    // 执行Level 2计划
+    execute_planned_fft(plan);
 }
 
+// ============================================
+// 片外六步法处理模式（帧大于AM）
+// ============================================
+
 template <typename T>
-void FFT_Initiator<T>::execute_level2_2d_fft(size_t L2_N1, size_t L2_N2) {
-    cout << "\n[L2-2D] Starting Level 2 2D decomposition..." << endl;
-    
-    // 获取输入数据
-    vector<complex<T>> input_data = frame_input_data[current_frame_id];
-    
-    // 重排为Level 2矩阵 (L2_N2 × L2_N1)
-    auto L2_matrix = FFTInitiatorUtils::reshape_to_matrix(input_data, L2_N2, L2_N1);
-    
-    // 初始化Level 2中间矩阵
-    vector<vector<complex<T>>> L2_G_matrix(L2_N2, vector<complex<T>>(L2_N1));
-    vector<vector<complex<T>>> L2_H_matrix(L2_N2, vector<complex<T>>(L2_N1));
-    vector<vector<complex<T>>> L2_X_matrix(L2_N2, vector<complex<T>>(L2_N1));
-    
-    // ====== Stage 1: Level 2列FFT ======
-    cout << "\n[L2-Stage1] Processing " << L2_N1 << " columns, each " << L2_N2 << " points" << endl;
-    
-    for (size_t col = 0; col < L2_N1; col++) {
-        if (col % 16 == 0) {  // 每16列输出一次进度
-            cout << "  Processing columns " << col << "-" << min(col+15, L2_N1-1) 
-                 << " / " << L2_N1 << endl;
-        }
-        
-        // 提取列数据
-        vector<complex<float>> column_data(L2_N2);
-        for (size_t row = 0; row < L2_N2; row++) {
-            column_data[row] = complex<float>(
-                L2_matrix[row][col].real,
-                L2_matrix[row][col].imag
-            );
-        }
-        
-        // 对这一列执行FFT（可能需要Level 1分解）
-        vector<complex<float>> col_result = perform_adaptive_fft(column_data, L2_N2);
-        
-        // 存储结果
-        for (size_t row = 0; row < L2_N2; row++) {
-            L2_G_matrix[row][col] = complex<T>(col_result[row].real, col_result[row].imag);
-        }
-    }
-    
-    // ====== Stage 2: Level 2旋转因子 ======
-    cout << "\n[L2-Stage2] Applying twiddle factors for " << TEST_FFT_SIZE << "-point FFT" << endl;
-    
-    for (size_t n2 = 0; n2 < L2_N2; n2++) {
-        for (size_t k1 = 0; k1 < L2_N1; k1++) {
-            complex<float> twiddle = FFTInitiatorUtils::compute_twiddle_factor(n2, k1, TEST_FFT_SIZE);
-            complex<float> G_val(L2_G_matrix[n2][k1].real, L2_G_matrix[n2][k1].imag);
-            complex<float> H_val = twiddle * G_val;
-            L2_H_matrix[n2][k1] = complex<T>(H_val.real, H_val.imag);
-        }
-    }
+void FFT_Initiator<T>::process_frame_six_step_mode() {
+    cout << "[FRAME-6S] Using out-of-core six-step mode" << endl;
     
-    // ====== Stage 3: Level 2行FFT ======
-    cout << "\n[L2-Stage3] Processing " << L2_N2 << " rows, each " << L2_N1 << " points" << endl;
+    prepare_frame_data_once();
     
-    for (size_t row = 0; row < L2_N2; row++) {
-        if (row % 16 == 0) {  // 每16行输出一次进度
-            cout << "  Processing rows " << row << "-" << min(row+15, L2_N2-1) 
-                 << " / " << L2_N2 << endl;
-        }
-        
-        // 提取行数据
-        vector<complex<float>> row_data(L2_N1);
-        for (size_t col = 0; col < L2_N1; col++) {
-            row_data[col] = complex<float>(
-                L2_H_matrix[row][col].real,
-                L2_H_matrix[row][col].imag
-            );
-        }
-        
-        // 对这一行执行FFT（可能需要Level 1分解）
-        vector<complex<float>> row_result = perform_adaptive_fft(row_data, L2_N1);
-        
-        // 存储结果
-        for (size_t col = 0; col < L2_N1; col++) {
-            L2_X_matrix[row][col] = complex<T>(row_result[col].real, row_result[col].imag);
-        }
-    }
+    // 输入留在DDR原位做中间结果，最终自然序结果转置到紧随其后的区域
+    uint64_t ddr_data_addr = FFTInitiatorUtils::calculate_ddr_address(current_frame_id, TEST_FFT_SIZE, DDR_BASE_ADDR);
+    uint64_t ddr_out_addr = ddr_data_addr + TEST_FFT_SIZE * sizeof(complex<T>);
+    execute_six_step_fft(ddr_data_addr, ddr_out_addr);
     
-    // 重排回一维
-    vector<complex<T>> final_output = FFTInitiatorUtils::reshape_to_vector(L2_X_matrix);
-    frame_output_data[current_frame_id] = final_output;
+    vector<complex<T>> final_output;
+    ins::read_from_dmi_bulk<complex<T>>(ddr_out_addr, final_output, this->ddr_dmi, TEST_FFT_SIZE, "FFT_Initiator", &this->qk);
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, final_output);
     
-    // 显示部分结果
-    cout << "\n[L2-2D] Level 2 FFT completed. Output samples:" << endl;
     cout << "  First 8 points: ";
     for (size_t i = 0; i < min(size_t(8), final_output.size()); i++) {
         cout << "(" << fixed << setprecision(2) 
@@ -312,176 +401,385 @@ void FFT_Initiator<T>::execute_level2_2d_fft(size_t L2_N1, size_t L2_N2) {
     perform_final_verification();
 }
 
-// ============================================
-// 自适应FFT执行器（根据大小选择策略）
-// ============================================
-
 template <typename T>
-vector<complex<float>> FFT_Initiator<T>::perform_adaptive_fft(
-    const vector<complex<float>>& input, 
-    size_t fft_size
-) {
-        // 添加输入验证
-    if (input.size() != fft_size) {
-        cout << "WARNING: Input size mismatch. Expected: " << fft_size 
-             << ", Got: " << input.size() << endl;
+void FFT_Initiator<T>::execute_six_step_fft(uint64_t ddr_data_addr, uint64_t ddr_out_addr) {
+    const size_t fft_size = TEST_FFT_SIZE;
+    auto layout = FFTInitiatorUtils::make_six_step_layout(fft_size, AM_SIZE / sizeof(complex<float>));
+    if (!layout.is_valid) {
+        cout << "ERROR: No six-step layout for " << fft_size << " points in " << AM_SIZE << " bytes of AM" << endl;
+        return;
     }
-    // Level 0: 硬件直接处理
-    if (fft_size <= FFT_TLM_N) {
-        return perform_fft_core(input, fft_size);
+    const size_t n1 = layout.n1;
+    const size_t n2 = layout.n2;
+    const uint64_t elem = sizeof(complex<float>);
+    const uint64_t buffer_bytes = layout.buffer_elems * elem;
+    
+    // AM布局：槽s的面板缓冲区及其转置缓冲区
+    auto panel_addr = [&](unsigned slot) { return AM_BASE_ADDR + 2 * slot * buffer_bytes; };
+    auto trans_addr = [&](unsigned slot) { return panel_addr(slot) + buffer_bytes; };
+    
+    auto& col_plan = get_fft_plan(n2);
+    auto& row_plan = get_fft_plan(n1);
+    // 转置后的列面板按 n1 x n2 行主序排列，旋转因子表取同样布局
+    const auto& twiddles = FFTInitiatorUtils::compensation_twiddles(n1, n2);
+    
+    cout << "\n[6-STEP] " << n2 << " x " << n1 << " matrix in DDR, "
+         << layout.col_panel << "-column / " << layout.row_panel << "-row AM panels" << endl;
+    
+    // Pass 1: 列FFT + 旋转因子。DDR中P列(n2行，行间距n1)搬入AM，DMA转置成P行后做n2点FFT
+    const size_t P = layout.col_panel;
+    run_panel_pipeline(n1 / P,
+        [&](size_t panel, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  ddr_data_addr + panel * P * elem, n1 * elem, P * elem, n2,
+                                  panel_addr(slot), P * elem, P * elem, n2, 0, &this->qk);
+        },
+        [&](size_t panel, unsigned slot) {
+            ins::dma_nb_handle transpose_handle;
+            ins::dma_matrix_transpose_trans_nb(this->socket, transpose_handle, panel_addr(slot), trans_addr(slot),
+                                               n2, P, elem, true, 2, &this->qk);
+            ins::dma_nb_wait(transpose_handle);
+            
+            // 旋转因子 W_N^(col*k2) 在列结果写出时一并乘上，表按面板内布局[i*n2 + k2]取
+            auto cols = ins::dmi_view<complex<float>>(trans_addr(slot), this->am_dmi, P * n2, "FFT_Initiator");
+            col_plan.execute_batch(P, cols.data(), 1, n2, cols.data(), 1, n2,
+                                   twiddles.data() + panel * P * n2);
+            
+            ins::dma_matrix_transpose_trans_nb(this->socket, transpose_handle, trans_addr(slot), panel_addr(slot),
+                                               P, n2, elem, true, 2, &this->qk);
+            ins::dma_nb_wait(transpose_handle);
+        },
+        [&](size_t panel, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  panel_addr(slot), P * elem, P * elem, n2,
+                                  ddr_data_addr + panel * P * elem, n1 * elem, P * elem, n2, 1, &this->qk);
+        });
+    
+    // Pass 2: 行FFT，R行连续搬入AM
+    const size_t R = layout.row_panel;
+    const uint64_t row_panel_bytes = R * n1 * elem;
+    run_panel_pipeline(n2 / R,
+        [&](size_t panel, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  ddr_data_addr + panel * row_panel_bytes, row_panel_bytes, row_panel_bytes, 1,
+                                  panel_addr(slot), row_panel_bytes, row_panel_bytes, 1, 0, &this->qk);
+        },
+        [&](size_t panel, unsigned slot) {
+            auto rows = ins::dmi_view<complex<float>>(panel_addr(slot), this->am_dmi, R * n1, "FFT_Initiator");
+            row_plan.execute_batch(R, rows.data(), 1, n1, rows.data(), 1, n1);
+        },
+        [&](size_t panel, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  panel_addr(slot), row_panel_bytes, row_panel_bytes, 1,
+                                  ddr_data_addr + panel * row_panel_bytes, row_panel_bytes, row_panel_bytes, 1, 1, &this->qk);
+        });
+    
+    // Pass 3: DDR中X[k2][k1]整体转置为自然序 X[n2*k1 + k2]
+    ins::dma_matrix_transpose_trans(this->socket, ddr_data_addr, ddr_out_addr, n2, n1, elem, true, 2, &this->qk);
+}
+
+template <typename T>
+void FFT_Initiator<T>::run_panel_pipeline(size_t panel_num, const PanelDma& load,
+                                          const PanelCompute& compute, const PanelDma& store) {
+    if (panel_num == 0) {
+        return;
     }
-    
-    // Level 1: 需要2D分解
-    size_t level1_max = FFT_TLM_N * FFT_TLM_N;
-    if (fft_size <= level1_max) {
-        // 找到合适的分解
-        size_t n1 = FFT_TLM_N;
-        size_t n2 = fft_size / FFT_TLM_N;
+    ins::dma_nb_handle load_handle[2];
+    ins::dma_nb_handle store_handle[2];
+    bool store_pending[2] = {false, false};
+    
+    load(0, 0, load_handle[0]);
+    for (size_t panel = 0; panel < panel_num; panel++) {
+        unsigned slot = panel & 1;
+        unsigned next = slot ^ 1;
+        ins::dma_nb_wait(load_handle[slot]);
         
-        // 如果不能整除，尝试方形分解
-        if (n1 * n2 != fft_size) {
-            size_t sqrt_size = static_cast<size_t>(sqrt(fft_size));
-            if (sqrt_size * sqrt_size == fft_size) {
-                n1 = sqrt_size;
-                n2 = sqrt_size;
+        // 预取下一块到另一个槽，该槽上一块的写回必须先完成
+        if (panel + 1 < panel_num) {
+            if (store_pending[next]) {
+                ins::dma_nb_wait(store_handle[next]);
+                store_pending[next] = false;
             }
+            load(panel + 1, next, load_handle[next]);
         }
         
-        return perform_level1_2d_fft_internal(input, n1, n2, fft_size);
+        compute(panel, slot);
+        store(panel, slot, store_handle[slot]);
+        store_pending[slot] = true;
+    }
+    for (unsigned slot = 0; slot < 2; slot++) {
+        if (store_pending[slot]) {
+            ins::dma_nb_wait(store_handle[slot]);
+        }
     }
-    
-    // 超出处理能力
-    cout << "ERROR: FFT size " << fft_size << " exceeds adaptive processing capability" << endl;
-    return input;  // 返回原始数据
 }
 
+// ============================================
+// 实数输入处理模式
+// ============================================
+
 template <typename T>
-vector<complex<float>> FFT_Initiator<T>::perform_level1_2d_fft_internal(
-    const vector<complex<float>>& input,
-    size_t n1, size_t n2, size_t total_size
-) {
-    // 重排为矩阵
-    vector<vector<complex<float>>> matrix(n2, vector<complex<float>>(n1));
-    for (size_t i = 0; i < total_size; i++) {
-        matrix[i / n1][i % n1] = input[i];
+bool FFT_Initiator<T>::process_frame_real_mode() {
+    const size_t n = TEST_FFT_SIZE;
+    const size_t bins = n / 2 + 1;
+    const unsigned first_frame = current_frame_id;
+    const bool pair = real_pack_two_frames && first_frame + 1 < test_frames_count;
+    
+    cout << "[FRAME-REAL] " << (pair ? "Two real frames packed into one complex FFT" 
+                                     : "Real FFT as an N/2-point complex FFT") << endl;
+    
+    // 生成实数帧并计算各自的参考结果
+    vector<vector<float>> frames;
+    for (unsigned f = first_frame; f < first_frame + (pair ? 2 : 1); f++) {
+        current_frame_id = f;
+        auto test_data = generate_frame_test_data();
+        compute_reference_results(test_data);
+        vector<float> samples(n);
+        for (size_t i = 0; i < n; i++) {
+            samples[i] = test_data[i].real;
+        }
+        frames.push_back(samples);
     }
+    current_frame_id = first_frame;
     
-    // Stage 1: 列FFT
-    for (size_t col = 0; col < n1; col++) {
-        vector<complex<float>> column(n2);
-        for (size_t row = 0; row < n2; row++) {
-            column[row] = matrix[row][col];
-        }
-        
-        auto col_result = perform_fft_core(column, n2);
-        
-        for (size_t row = 0; row < n2; row++) {
-            matrix[row][col] = col_result[row];
-        }
+    // 打包为一个复数帧后搬运，搬运量与实数数据量相同
+    const size_t packed_size = pair ? n : n / 2;
+    vector<complex<float>> packed(packed_size);
+    if (pair) {
+        FFTInitiatorUtils::pack_real_pair(frames[0].data(), frames[1].data(), packed.data(), n);
+    } else {
+        FFTInitiatorUtils::pack_real_half(frames[0].data(), packed.data(), n);
     }
+    perform_data_movement(vector<complex<T>>(packed.begin(), packed.end()));
     
-    // Stage 2: 旋转因子
-    for (size_t n2_idx = 0; n2_idx < n2; n2_idx++) {
-        for (size_t k1_idx = 0; k1_idx < n1; k1_idx++) {
-            complex<float> twiddle = FFTInitiatorUtils::compute_twiddle_factor(n2_idx, k1_idx, total_size);
-            matrix[n2_idx][k1_idx] = twiddle * matrix[n2_idx][k1_idx];
-        }
+    // 复数FFT
+    auto staged = frame_arena.get(first_frame, FFTInitiatorUtils::FRAME_INPUT);
+    vector<complex<float>> spectrum(packed_size);
+    for (size_t i = 0; i < packed_size; i++) {
+        spectrum[i] = complex<float>(staged[i].real, staged[i].imag);
     }
+    get_fft_plan(packed_size).execute(spectrum.data(), spectrum.data());
     
-    // Stage 3: 行FFT
-    for (size_t row = 0; row < n2; row++) {
-        vector<complex<float>> row_data(n1);
-        for (size_t col = 0; col < n1; col++) {
-            row_data[col] = matrix[row][col];
-        }
-        
-        auto row_result = perform_fft_core(row_data, n1);
-        
-        for (size_t col = 0; col < n1; col++) {
-            matrix[row][col] = row_result[col];
-        }
+    // 拆分后处理，每帧输出n/2+1个频点
+    vector<vector<complex<float>>> outputs(frames.size(), vector<complex<float>>(bins));
+    if (pair) {
+        FFTInitiatorUtils::split_real_pair(spectrum.data(), n, outputs[0].data(), outputs[1].data());
+    } else {
+        FFTInitiatorUtils::real_half_post_twiddle(spectrum.data(), n, outputs[0].data());
     }
     
-    // 重排回一维
-    vector<complex<float>> output(total_size);
-    for (size_t i = 0; i < total_size; i++) {
-        output[i] = matrix[i / n1][i % n1];
+    for (size_t i = 0; i < outputs.size(); i++) {
+        current_frame_id = first_frame + i;
+        frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, outputs[i]);
+        frame_arena.resize(current_frame_id, FFTInitiatorUtils::FRAME_REFERENCE, bins);
+        perform_final_verification();
     }
+    current_frame_id = first_frame;
     
-    return output;
+    return pair;
 }
 
 // ============================================
-// Level 1专用处理函数
+// 快速卷积处理模式（FFT -> 频谱乘 -> IFFT）
 // ============================================
 
 template <typename T>
-void FFT_Initiator<T>::process_level1_column_fft() {
-    cout << "\n  [L1-Stage1] Column FFT Processing..." << endl;
+void FFT_Initiator<T>::process_frame_convolution_mode() {
+    cout << "[FRAME-CONV] Using fast convolution mode" << endl;
+    
+    const size_t signal_len = TEST_FFT_SIZE;
+    const size_t L = conv_filter_len;
+    const size_t step = conv_block_size - L + 1;
+    const size_t blocks = (signal_len + step - 1) / step;
+    
+    // 测试滤波器：固定的衰减复数抽头
+    vector<complex<float>> taps(L);
+    for (size_t j = 0; j < L; j++) {
+        taps[j] = complex<float>(1.0f / (j + 1), 0.1f * j);
+    }
     
-    auto& input_matrix = frame_data_matrix[current_frame_id];
-    auto& G_matrix = frame_G_matrix[current_frame_id];
+    auto test_data = generate_frame_test_data();
     
-    for (size_t col = 0; col < N1; col++) {
-        vector<complex<float>> column_data(N2);
-        for (size_t row = 0; row < N2; row++) {
-            column_data[row] = complex<float>(
-                input_matrix[row][col].real,
-                input_matrix[row][col].imag
-            );
-        }
-        cout << sc_time_stamp() << "开始计算col_result"  << endl;
-        auto col_result = perform_fft_core(column_data, N2);
-        cout << sc_time_stamp() << "完成计算col_result"  << endl;
-        for (size_t row = 0; row < N2; row++) {
-            G_matrix[row][col] = complex<T>(col_result[row].real, col_result[row].imag);
+    // 参考结果：直接卷积
+    vector<complex<T>> reference(signal_len);
+    for (size_t i = 0; i < signal_len; i++) {
+        float re = 0, im = 0;
+        for (size_t j = 0; j < L && j <= i; j++) {
+            complex<float> v = taps[j] * complex<float>(test_data[i - j].real, test_data[i - j].imag);
+            re += v.real;
+            im += v.imag;
         }
+        reference[i] = complex<T>(re, im);
+    }
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_REFERENCE, reference);
+    
+    // 输入前补L-1个零，尾部补齐最后一块；卷积缓冲区放在所有帧区域之后
+    const size_t padded_len = blocks * step + L - 1;
+    vector<complex<T>> padded(padded_len, complex<T>(0, 0));
+    for (size_t i = 0; i < signal_len; i++) {
+        padded[L - 1 + i] = test_data[i];
+    }
+    uint64_t ddr_in_addr = FFTInitiatorUtils::calculate_ddr_address(test_frames_count, TEST_FFT_SIZE, DDR_BASE_ADDR);
+    uint64_t ddr_out_addr = ddr_in_addr + padded_len * sizeof(complex<T>);
+    write_data_to_ddr(padded, ddr_in_addr);
+    
+    run_fast_convolution(0, taps, ddr_in_addr, ddr_out_addr, signal_len);
+    
+    vector<complex<T>> filtered;
+    ins::read_from_dmi_bulk<complex<T>>(ddr_out_addr, filtered, this->ddr_dmi, signal_len, "FFT_Initiator", &this->qk);
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, filtered);
+    
+    perform_final_verification();
+}
+
+template <typename T>
+const vector<complex<float>>& FFT_Initiator<T>::get_filter_spectrum(unsigned filter_id, const vector<complex<float>>& taps,
+                                                                    size_t block_size) {
+    auto key = make_pair(filter_id, block_size);
+    auto it = conv_filter_spectra.find(key);
+    if (it == conv_filter_spectra.end()) {
+        it = conv_filter_spectra.emplace(key, FFTInitiatorUtils::filter_spectrum(get_fft_plan(block_size), taps)).first;
     }
-    cout << "  [L1-Stage1] All column FFTs completed" << endl;
+    return it->second;
 }
 
 template <typename T>
-void FFT_Initiator<T>::process_level1_twiddle() {
-    cout << "\n  [L1-Stage2] Twiddle Factor Compensation..." << endl;
-    
-    auto& G_matrix = frame_G_matrix[current_frame_id];
-    auto& H_matrix = frame_H_matrix[current_frame_id];
+void FFT_Initiator<T>::run_fast_convolution(unsigned filter_id, const vector<complex<float>>& taps,
+                                            uint64_t ddr_in_addr, uint64_t ddr_out_addr, size_t signal_len) {
+    const size_t n = conv_block_size;
+    const size_t L = taps.size();
+    const uint64_t elem = sizeof(complex<float>);
+    if (L == 0 || L > n || 3 * n * elem > AM_SIZE) {
+        cout << "ERROR: Invalid fast convolution setup (" << L << " taps, " << n << "-point blocks)" << endl;
+        return;
+    }
+    const size_t step = n - L + 1;
+    const size_t blocks = (signal_len + step - 1) / step;
+    
+    auto& plan = get_fft_plan(n);
+    const auto& spectrum = get_filter_spectrum(filter_id, taps, n);
+    
+    // AM布局：[滤波器频谱][块槽0][块槽1]，频谱在整个滤波过程中常驻AM
+    const uint64_t spectrum_addr = AM_BASE_ADDR;
+    auto slot_addr = [&](unsigned slot) { return AM_BASE_ADDR + (1 + slot) * n * elem; };
+    uint64_t end_addr;
+    ins::write_to_dmi_bulk<complex<float>>(spectrum_addr, end_addr, spectrum, this->am_dmi, n, "FFT_Initiator", &this->qk);
+    auto H = ins::dmi_view<complex<float>>(spectrum_addr, this->am_dmi, n, "FFT_Initiator");
+    
+    cout << "\n[FAST-CONV] " << blocks << " blocks of " << n << " points, " << step << " outputs per block" << endl;
+    
+    // 重叠保留：块p读取输入[p*step, p*step+n)，输出后n-L+1个点
+    run_panel_pipeline(blocks,
+        [&](size_t block, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  ddr_in_addr + block * step * elem, n * elem, n * elem, 1,
+                                  slot_addr(slot), n * elem, n * elem, 1, 0, &this->qk);
+        },
+        [&](size_t block, unsigned slot) {
+            // 数据在AM中原地完成 FFT -> 频谱乘 -> IFFT，中间不回DDR
+            auto x = ins::dmi_view<complex<float>>(slot_addr(slot), this->am_dmi, n, "FFT_Initiator");
+            plan.execute(x.data(), x.data());
+            FFTInitiatorUtils::pointwise_multiply(x.data(), H.data(), n);
+            plan.execute_inverse(x.data(), x.data());
+        },
+        [&](size_t block, unsigned slot, ins::dma_nb_handle& handle) {
+            ins::dma_p2p_trans_nb(this->socket, handle,
+                                  slot_addr(slot) + (L - 1) * elem, step * elem, step * elem, 1,
+                                  ddr_out_addr + block * step * elem, step * elem, step * elem, 1, 1, &this->qk);
+        });
+}
+
+// ============================================
+// FFT计划：按点数创建一次，之后每帧直接执行
+// ============================================
+
+template <typename T>
+FFTInitiatorUtils::FFTPlan& FFT_Initiator<T>::get_fft_plan(size_t fft_size) {
+    auto it = fft_plans.find(fft_size);
+    if (it != fft_plans.end()) {
+        return *it->second;
+    }
     
-    for (size_t n2 = 0; n2 < N2; n2++) {
-        for (size_t k1 = 0; k1 < N1; k1++) {
-            complex<float> twiddle = FFTInitiatorUtils::compute_twiddle_factor(n2, k1, TEST_FFT_SIZE);
-            complex<float> G_val(G_matrix[n2][k1].real, G_matrix[n2][k1].imag);
-            complex<float> H_val = twiddle * G_val;
-            H_matrix[n2][k1] = complex<T>(H_val.real, H_val.imag);
-            //wait(19,SC_NS);
+    // 叶子变换绑定到硬件批量FFT
+    auto leaf = [this](size_t n, size_t howmany,
+                       const complex<float>* in, size_t istride, size_t idist,
+                       complex<float>* out, size_t ostride, size_t odist,
+                       const complex<float>* post) {
+        perform_fft_batch(n, howmany, in, istride, idist, out, ostride, odist, post);
+    };
+    unique_ptr<FFTInitiatorUtils::FFTPlan> plan(new FFTInitiatorUtils::FFTPlan(fft_size, FFT_TLM_N, leaf));
+    
+    // 叶子点数对应的硬件配置一并预先生成
+    for (size_t n : plan->leaf_sizes()) {
+        if (fft_config_by_size.find(n) == fft_config_by_size.end()) {
+            fft_config_by_size.emplace(n, FFTInitiatorUtils::create_fft_configuration(FFT_TLM_N, n));
         }
     }
-    cout << "  [L1-Stage2] Twiddle compensation completed" << endl;
+    
+    cout << "[FFT-PLAN] Created plan for " << fft_size << " points"
+         << (plan->valid() ? "" : " (INVALID)") << ", leaf sizes:";
+    for (size_t n : plan->leaf_sizes()) cout << " " << n;
+    cout << endl;
+    
+    return *fft_plans.emplace(fft_size, std::move(plan)).first->second;
 }
 
 template <typename T>
-void FFT_Initiator<T>::process_level1_row_fft() {
-    cout << "\n  [L1-Stage3] Row FFT Processing..." << endl;
+uint64_t FFT_Initiator<T>::execute_corner_turn_fft(FFTInitiatorUtils::FFTPlan& plan,
+                                                   uint64_t data_addr, uint64_t scratch_addr) {
+    const size_t n = plan.size();
+    const FFTInitiatorUtils::FFTPlanNode* root = plan.root();
+    if (root->kind != FFTInitiatorUtils::FFTPlanNode::COOLEY_TUKEY) {
+        // 素因子/Bluestein的索引映射不是矩阵转置，直接在AM内原地执行
+        auto x = ins::dmi_view<complex<float>>(data_addr, this->am_dmi, n, "FFT_Initiator");
+        plan.execute(x.data(), x.data());
+        return data_addr;
+    }
     
-    auto& H_matrix = frame_H_matrix[current_frame_id];
-    auto& X_matrix = frame_X_matrix[current_frame_id];
+    const size_t n1 = root->n1;
+    const size_t n2 = root->n2;
+    const uint32_t elem = sizeof(complex<float>);
+    auto& col_plan = get_fft_plan(n2);
+    auto& row_plan = get_fft_plan(n1);
+    // 转置后列FFT输出按 n1 x n2 行主序[j1*n2 + k2]，旋转因子表取同样布局
+    const auto& twiddles = FFTInitiatorUtils::compensation_twiddles(n1, n2);
+    auto data = ins::dmi_view<complex<float>>(data_addr, this->am_dmi, n, "FFT_Initiator");
+    auto turned = ins::dmi_view<complex<float>>(scratch_addr, this->am_dmi, n, "FFT_Initiator");
+    
+    // 转角1：n2 x n1 → n1 x n2，每一列变为连续的n2个点
+    ins::dma_matrix_transpose_trans(this->socket, data_addr, scratch_addr, n2, n1, elem, true, 2, &this->qk);
+    col_plan.execute_batch(n1, turned.data(), 1, n2, turned.data(), 1, n2, twiddles.data());
+    
+    // 转角2：n1 x n2 → n2 x n1，每一行变为连续的n1个点
+    ins::dma_matrix_transpose_trans(this->socket, scratch_addr, data_addr, n1, n2, elem, true, 2, &this->qk);
+    row_plan.execute_batch(n2, data.data(), 1, n1, data.data(), 1, n1);
+    
+    // 转角3：[k2*n1 + k1] → [k1*n2 + k2]，即自然序 X[n2*k1 + k2]
+    ins::dma_matrix_transpose_trans(this->socket, data_addr, scratch_addr, n2, n1, elem, true, 2, &this->qk);
+    return scratch_addr;
+}
+
+template <typename T>
+void FFT_Initiator<T>::execute_planned_fft(FFTInitiatorUtils::FFTPlan& plan) {
+    cout << "\n[FFT-PLAN] Executing " << plan.size() << "-point plan in AM..." << endl;
     
-    for (size_t row = 0; row < N2; row++) {
-        vector<complex<float>> row_data(N1);
-        for (size_t col = 0; col < N1; col++) {
-            row_data[col] = complex<float>(
-                H_matrix[row][col].real,
-                H_matrix[row][col].imag
-            );
-        }
-        
-        auto row_result = perform_fft_core(row_data, N1);
-        
-        for (size_t col = 0; col < N1; col++) {
-            X_matrix[row][col] = complex<T>(row_result[col].real, row_result[col].imag);
-        }
+    // 帧槽前半是帧数据，后半（搬入时的旋转因子副本区）用作转角缓冲
+    uint64_t am_data_addr = FFTInitiatorUtils::calculate_am_address(current_frame_id, TEST_FFT_SIZE, AM_BASE_ADDR, AM_SIZE);
+    uint64_t am_scratch_addr = am_data_addr + TEST_FFT_SIZE * sizeof(complex<T>);
+    uint64_t result_addr = execute_corner_turn_fft(plan, am_data_addr, am_scratch_addr);
+    
+    vector<complex<T>> final_output;
+    ins::read_from_dmi<complex<T>>(result_addr, final_output, this->am_dmi, plan.size(), "FFT_Initiator", &this->qk);
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, final_output);
+    
+    cout << "  First 8 points: ";
+    for (size_t i = 0; i < min(size_t(8), final_output.size()); i++) {
+        cout << "(" << fixed << setprecision(2) 
+             << final_output[i].real << "," << final_output[i].imag << ") ";
     }
-    cout << "  [L1-Stage3] All row FFTs completed" << endl;
+    cout << endl;
+    
+    perform_final_verification();
 }
 
 template <typename T>
@@ -536,12 +834,7 @@ void FFT_Initiator<T>::prepare_frame_data_once() {
     // Step 3: 计算参考结果
     compute_reference_results(test_data);
     
-    // Step 4: 如果是2D模式，将数据重排为矩阵
-    if (use_2d_decomposition) {
-        vector<complex<T>> input_data = frame_input_data[current_frame_id];
-        frame_data_matrix[current_frame_id] = FFTInitiatorUtils::reshape_to_matrix(input_data, N2, N1);
-        cout << "  - Data reshaped to " << N2 << "x" << N1 << " matrix" << endl;
-    }
+    // 2D模式不在主机侧重排矩阵，列/行之间的转角由AM内的DMA转置完成
     
     frame_data_ready = true;
     cout << "[DATA-PREP] Frame data preparation completed" << endl;
@@ -620,9 +913,12 @@ template <typename T>
 void FFT_Initiator<T>::initialize_2d_matrices() {
     cout << "  [2D-INIT] Initializing matrices (N1=" << N1 << ", N2=" << N2 << ")" << endl;
     
-    frame_G_matrix[current_frame_id].assign(N2, vector<complex<T>>(N1, complex<T>(0,0)));
-    frame_H_matrix[current_frame_id].assign(N2, vector<complex<T>>(N1, complex<T>(0,0)));
-    frame_X_matrix[current_frame_id].assign(N2, vector<complex<T>>(N1, complex<T>(0,0)));
+    // G/H/X三个N2×N1矩阵共用一块扁平缓冲，只服务当前帧
+    const size_t points = static_cast<size_t>(N1) * N2;
+    work_2d.assign(3 * points, complex<T>(0,0));
+    G_matrix = FFTInitiatorUtils::matrix_view(work_2d.data(), N2, N1);
+    H_matrix = FFTInitiatorUtils::matrix_view(work_2d.data() + points, N2, N1);
+    X_matrix = FFTInitiatorUtils::matrix_view(work_2d.data() + 2 * points, N2, N1);
 }
 
 template <typename T>
@@ -630,20 +926,18 @@ void FFT_Initiator<T>::process_2d_stage1_column_fft() {
     cout << "\n  [Stage 1] Column FFT Processing..." << endl;
     current_2d_stage = 1;
     
-    auto& input_matrix = frame_data_matrix[current_frame_id];
-    auto& G_matrix = frame_G_matrix[current_frame_id];
+    // 输入本身就是N2×N1行主序矩阵，直接取视图
+    auto input_matrix = frame_arena.matrix(current_frame_id, FFTInitiatorUtils::FRAME_INPUT, N2, N1);
     
     // 对每一列进行N2点FFT
     for (current_column_id = 0; current_column_id < N1; current_column_id++) {
         cout << "    - Column " << current_column_id + 1 << "/" << N1 << ": ";
         
-        // 提取列数据
+        // 提取列数据：列视图即 (指针, 步长N1)
+        auto column = input_matrix.col(current_column_id);
         vector<complex<float>> column_data(N2);
         for (unsigned row = 0; row < N2; row++) {
-            column_data[row] = complex<float>(
-                input_matrix[row][current_column_id].real,
-                input_matrix[row][current_column_id].imag
-            );
+            column_data[row] = complex<float>(column[row].real, column[row].imag);
         }
         
         // 直接调用FFT计算核心（不触发数据生成）
@@ -651,7 +945,7 @@ void FFT_Initiator<T>::process_2d_stage1_column_fft() {
         
         // 存储结果到G矩阵
         for (unsigned row = 0; row < N2; row++) {
-            G_matrix[row][current_column_id] = complex<T>(
+            G_matrix(row, current_column_id) = complex<T>(
                 column_fft_result[row].real,
                 column_fft_result[row].imag
             );
@@ -668,16 +962,13 @@ void FFT_Initiator<T>::process_2d_stage2_twiddle() {
     cout << "\n  [Stage 2] Twiddle Factor Compensation..." << endl;
     current_2d_stage = 2;
     
-    auto& G_matrix = frame_G_matrix[current_frame_id];
-    auto& H_matrix = frame_H_matrix[current_frame_id];
-    
     // 应用旋转因子补偿: H(n2,k1) = W_M^(n2*k1) * G(n2,k1)
     for (unsigned n2 = 0; n2 < N2; n2++) {
         for (unsigned k1 = 0; k1 < N1; k1++) {
             complex<float> twiddle = FFTInitiatorUtils::compute_twiddle_factor(n2, k1, FFT_TLM_N);
-            complex<float> G_val(G_matrix[n2][k1].real, G_matrix[n2][k1].imag);
+            complex<float> G_val(G_matrix(n2, k1).real, G_matrix(n2, k1).imag);
             complex<float> H_val = twiddle * G_val;
-            H_matrix[n2][k1] = complex<T>(H_val.real, H_val.imag);
+            H_matrix(n2, k1) = complex<T>(H_val.real, H_val.imag);
         }
     }
     
@@ -686,7 +977,7 @@ void FFT_Initiator<T>::process_2d_stage2_twiddle() {
     for (unsigned r = 0; r < N2; ++r) {
         cout << "      Row " << r << ": ";
         for (unsigned c = 0; c < N1; ++c) {
-            cout << "(" << fixed << setprecision(2) << H_matrix[r][c].real << "," << H_matrix[r][c].imag << ") ";
+            cout << "(" << fixed << setprecision(2) << H_matrix(r, c).real << "," << H_matrix(r, c).imag << ") ";
         }
         cout << endl;
     }
@@ -699,20 +990,15 @@ void FFT_Initiator<T>::process_2d_stage3_row_fft() {
     cout << "\n  [Stage 3] Row FFT Processing..." << endl;
     current_2d_stage = 3;
     
-    auto& H_matrix = frame_H_matrix[current_frame_id];
-    auto& X_matrix = frame_X_matrix[current_frame_id];
-    
     // 对每一行进行N1点FFT
     for (current_row_id = 0; current_row_id < N2; current_row_id++) {
         cout << "    - Row " << current_row_id + 1 << "/" << N2 << ": " << endl;
         
         // 提取行数据
+        auto row = H_matrix.row(current_row_id);
         vector<complex<float>> row_data(N1);
         for (unsigned col = 0; col < N1; col++) {
-            row_data[col] = complex<float>(
-                H_matrix[current_row_id][col].real,
-                H_matrix[current_row_id][col].imag
-            );
+            row_data[col] = complex<float>(row[col].real, row[col].imag);
         }
         
         // 直接调用FFT计算核心（不触发数据生成）
@@ -720,7 +1006,7 @@ void FFT_Initiator<T>::process_2d_stage3_row_fft() {
         
         // 存储结果到X矩阵
         for (unsigned col = 0; col < N1; col++) {
-            X_matrix[current_row_id][col] = complex<T>(
+            X_matrix(current_row_id, col) = complex<T>(
                 row_fft_result[col].real,
                 row_fft_result[col].imag
             );
@@ -740,7 +1026,9 @@ template <typename T>
 vector<complex<float>> FFT_Initiator<T>::perform_fft_core(const vector<complex<float>>& input, size_t fft_size) {
     // cout << "[DEBUG] perform_fft_core called: input.size()=" << input.size() << ", fft_size=" << fft_size << endl;
     
-    reconfigure_fft_hardware();
+    configure_fft_size(fft_size);
+    // FFT_TLM在独立进程中运行，发起计算前同步本地时间
+    lt_sync(&this->qk);
     
     // 直接使用输入数据，避免不必要的复制
     if (input.size() == fft_size) {
@@ -761,6 +1049,62 @@ vector<complex<float>> FFT_Initiator<T>::perform_fft_core(const vector<complex<f
     }
 }
 
+// ============================================
+// 批量FFT：整批只配置一次硬件，各变换按步长连续下发
+// ============================================
+
+template <typename T>
+void FFT_Initiator<T>::configure_fft_size(size_t fft_size) {
+    auto it = fft_config_by_size.find(fft_size);
+    if (it == fft_config_by_size.end()) {
+        it = fft_config_by_size.emplace(fft_size, FFTInitiatorUtils::create_fft_configuration(FFT_TLM_N, fft_size)).first;
+    }
+    apply_fft_configuration(it->second);
+}
+
+// 配置缓存：与FFT_TLM当前配置(点数、旁路掩码、共轭、移位)完全一致时不再发送配置事务
+template <typename T>
+bool FFT_Initiator<T>::apply_fft_configuration(const FFTConfiguration& config) {
+    FFTInitiatorUtils::FFTConfigKey key = FFTInitiatorUtils::make_config_key(config);
+    if (fft_config_valid && key == active_fft_config) {
+        fft_config_skipped++;
+        return false;
+    }
+    lt_sync(&this->qk);
+    send_fft_configure_transaction(config);
+    
+    lt_consume(&this->qk, sc_time(10, SC_NS));
+    active_fft_config = key;
+    fft_config_valid = true;
+    fft_config_sent++;
+    last_configured_fft_size = config.fft_size_real;
+    return true;
+}
+
+template <typename T>
+void FFT_Initiator<T>::perform_fft_batch(size_t fft_size, size_t howmany,
+                                         const complex<float>* in, size_t istride, size_t idist,
+                                         complex<float>* out, size_t ostride, size_t odist,
+                                         const complex<float>* post) {
+    // 硬件按log2旁路级数、输出按奇偶两半排列，只支持2的幂点数；其余点数须由计划走Bluestein
+    assert(FFTInitiatorUtils::is_supported_leaf_size(fft_size, FFT_TLM_N) && "FFT leaf size must be a power of two <= FFT_TLM_N");
+    configure_fft_size(fft_size);
+    // FFT_TLM在独立进程中运行，整批发起前同步一次本地时间
+    lt_sync(&this->qk);
+    
+    vector<complex<float>> hw_input(fft_size);
+    for (size_t b = 0; b < howmany; b++) {
+        const complex<float>* src = in + b * idist;
+        for (size_t i = 0; i < fft_size; i++) {
+            hw_input[i] = src[i * istride];
+        }
+        vector<complex<float>> hw_output = perform_fft(hw_input, fft_size);
+        // 旋转因子在输出重排时一并乘上，不再单独扫一遍
+        FFTInitiatorUtils::hw_output_to_natural(hw_output.data(), out + b * odist, fft_size, ostride,
+                                                post ? post + b * odist : nullptr);
+    }
+}
+
 // ============================================
 // FFT计算核心流程（修改版）
 // ============================================
@@ -776,25 +1120,16 @@ void FFT_Initiator<T>::FFT_computation_process() {
         // 这里只处理直接模式的计算
         if (!use_2d_decomposition || current_2d_stage == 0) {
             // 获取输入数据
-            vector<complex<T>> input_data = frame_input_data[current_frame_id];
+            auto input_data = frame_arena.get(current_frame_id, FFTInitiatorUtils::FRAME_INPUT);
             
             // 执行FFT计算
             vector<complex<float>> complex_input(input_data.begin(), input_data.end());
             vector<complex<float>> complex_output = this->perform_fft_core(complex_input, single_frame_fft_size);
             
-            // 存储结果
-            vector<complex<T>> output_data(complex_output.begin(), complex_output.end());
-
             //恢复为自然顺序，索引为偶的（0，2，4，。。。）为前半部分，索引为奇的（1，3，5，。。。）为后半部分
             vector<complex<T>> output_data_natural_order(single_frame_fft_size);
-            for (size_t i = 0; i < single_frame_fft_size; i++) {
-                if (i % 2 == 0) {
-                    output_data_natural_order[i] = output_data[i/2];
-                } else {
-                    output_data_natural_order[i] = output_data[single_frame_fft_size/2 + i/2];
-                }
-            }
-            frame_output_data[current_frame_id] = output_data_natural_order;
+            FFTInitiatorUtils::hw_output_to_natural(complex_output.data(), output_data_natural_order.data(), single_frame_fft_size);
+            frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, output_data_natural_order);
 
             // 显示输出
             cout << "  Output（自然顺序）: ";
@@ -844,18 +1179,16 @@ void FFT_Initiator<T>::FFT_single_frame_process() {
 
 template <typename T>
 void FFT_Initiator<T>::finalize_2d_results() {
-    // 将最终矩阵转换为输出向量
-    auto final_matrix = frame_X_matrix[current_frame_id];
-    vector<complex<T>> final_output = FFTInitiatorUtils::reshape_to_vector(final_matrix);
-    frame_output_data[current_frame_id] = final_output;
+    // X矩阵按行主序即为输出向量，直接整块写入输出缓冲
+    auto final_output = frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT, X_matrix.data, X_matrix.rows * X_matrix.cols);
     
     // 显示结果
     cout << "\n  Final 2D Output: ";
-    for (size_t i = 0; i < min(final_output.size(), size_t(8)); i++) {
+    for (size_t i = 0; i < min(final_output.size, size_t(8)); i++) {
         cout << "(" << fixed << setprecision(2) 
              << final_output[i].real << "," << final_output[i].imag << ") ";
     }
-    if (final_output.size() > 16) cout << "...";
+    if (final_output.size > 16) cout << "...";
     cout << endl;
 }
 
@@ -863,9 +1196,15 @@ template <typename T>
 void FFT_Initiator<T>::perform_final_verification() {
     cout << "\n[2D-VERIFY] Performing final verification..." << endl;
     
-    bool verification_passed = compare_complex_sequences(frame_output_data[current_frame_id], 
-                                        frame_reference_data[current_frame_id],1e-3f,true);
-    frame_test_results[current_frame_id] = verification_passed;
+    vector<complex<T>> output = frame_arena.get(current_frame_id, FFTInitiatorUtils::FRAME_OUTPUT).to_vector();
+    vector<complex<T>> reference = frame_arena.get(current_frame_id, FFTInitiatorUtils::FRAME_REFERENCE).to_vector();
+    bool verification_passed = compare_complex_sequences(output, reference,1e-3f,true);
+    total_frames_tested++;
+    if (verification_passed) {
+        frames_passed++;
+    } else {
+        frames_failed++;
+    }
     
     cout << "  Result: " << (verification_passed ? "PASS ✓" : "FAIL ✗") << endl;
 }
@@ -874,7 +1213,7 @@ void FFT_Initiator<T>::perform_final_verification() {
 
 template <typename T>
 bool FFT_Initiator<T>::should_reconfigure_fft() {
-    return single_frame_fft_size != last_configured_fft_size;
+    return !fft_config_valid || single_frame_fft_size != last_configured_fft_size;
 }
 
 template <typename T>
@@ -882,11 +1221,7 @@ void FFT_Initiator<T>::reconfigure_fft_hardware() {
     cout << "  [CONFIG] Reconfiguring FFT: " << last_configured_fft_size 
          << " -> " << single_frame_fft_size << " points" << endl;
     
-    FFTConfiguration config = FFTInitiatorUtils::create_fft_configuration(FFT_TLM_N, single_frame_fft_size);
-    send_fft_configure_transaction(config);
-    
-    wait(sc_time(10, SC_NS));
-    last_configured_fft_size = single_frame_fft_size;
+    configure_fft_size(single_frame_fft_size);
 }
 
 template <typename T>
@@ -898,6 +1233,13 @@ vector<complex<T>> FFT_Initiator<T>::generate_frame_test_data() {
         current_frame_id + 1
     );
     
+    // 实数输入模式只保留实部
+    if (real_input_mode) {
+        for (auto& val : test_data) {
+            val.imag = 0;
+        }
+    }
+    
     // 显示输入数据
     cout << "  Input: ";
     for (const auto& val : test_data) {
@@ -921,8 +1263,14 @@ void FFT_Initiator<T>::perform_data_movement(const vector<complex<T>>& test_data
     uint64_t ddr_twiddle_addr = ddr_data_addr + TEST_FFT_SIZE * sizeof(complex<T>);
     write_twiddle_factors_to_ddr(ddr_twiddle_addr);
     
+    // 片外模式：整帧放不下AM，由六步法按面板搬运
+    if (use_out_of_core) {
+        frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_INPUT, test_data);
+        return;
+    }
+    
     // Step 3: DMA传输到AM
-    uint64_t am_data_addr = FFTInitiatorUtils::calculate_am_address(current_frame_id, TEST_FFT_SIZE, AM_BASE_ADDR);
+    uint64_t am_data_addr = FFTInitiatorUtils::calculate_am_address(current_frame_id, TEST_FFT_SIZE, AM_BASE_ADDR, AM_SIZE);
     transfer_ddr_to_am(ddr_data_addr, am_data_addr, test_data.size());
     
     // Step 4: 从AM读取数据（模拟延迟）
@@ -937,65 +1285,75 @@ void FFT_Initiator<T>::write_data_to_ddr(const vector<complex<T>>& data, uint64_
 
 template <typename T>
 void FFT_Initiator<T>::write_twiddle_factors_to_ddr(uint64_t addr) {
-    auto twiddle_factors = calculate_twiddle_factors<float>(FFT_TLM_N);
+    const auto& twiddle_factors = cached_twiddle_factors<float>(FFT_TLM_N);
     vector<complex<T>> complex_twiddles(twiddle_factors.begin(), twiddle_factors.end());
     write_complex_data_dmi_no_latency(addr, complex_twiddles, complex_twiddles.size(), this->ddr_dmi);
 }
 
 template <typename T>
 void FFT_Initiator<T>::transfer_ddr_to_am(uint64_t src_addr, uint64_t dst_addr, size_t size) {
+    // 数据和旋转因子互不依赖，分别走DMA通道0和1以非阻塞方式同时发起
+    ins::dma_nb_handle data_handle;
+    ins::dma_nb_handle twiddle_handle;
+
     // 数据传输
-    ins::dma_p2p_trans(this->socket, 
+    ins::dma_p2p_trans_nb(this->socket, data_handle,
                       src_addr, 0, size * sizeof(complex<T>), 1,
-                      dst_addr, 0, size * sizeof(complex<T>), 1);
+                      dst_addr, 0, size * sizeof(complex<T>), 1, 0, &this->qk);
     
     // 旋转因子传输
     uint64_t twiddle_src = src_addr + TEST_FFT_SIZE * sizeof(complex<T>);
     uint64_t twiddle_dst = dst_addr + TEST_FFT_SIZE * sizeof(complex<T>);
-    ins::dma_p2p_trans(this->socket,
+    ins::dma_p2p_trans_nb(this->socket, twiddle_handle,
                       twiddle_src, 0, size * sizeof(complex<T>), 1,
-                      twiddle_dst, 0, size * sizeof(complex<T>), 1);
+                      twiddle_dst, 0, size * sizeof(complex<T>), 1, 1, &this->qk);
+
+    ins::dma_nb_wait(data_handle);
+    ins::dma_nb_wait(twiddle_handle);
 }
 
 template <typename T>
 void FFT_Initiator<T>::read_data_from_am(uint64_t addr, size_t size) {
     vector<complex<T>> data_read;
-    ins::read_from_dmi<complex<T>>(addr, data_read, this->am_dmi, size);
-    frame_input_data[current_frame_id] = data_read;
+    ins::read_from_dmi<complex<T>>(addr, data_read, this->am_dmi, size, "FFT_Initiator", &this->qk);
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_INPUT, data_read);
 }
 
 
 
 template <typename T>
 void FFT_Initiator<T>::display_final_statistics() {
-    int passed = 0;
-    for (bool result : frame_test_results) {
-        if (result) passed++;
-    }
+    int passed = frames_passed;
     
     cout << "\n====== Final Statistics ======" << endl;
     cout << "Total frames: " << test_frames_count << endl;
     cout << "Passed: " << passed << endl;
     cout << "Failed: " << (test_frames_count - passed) << endl;
     cout << "Success rate: " << (100.0 * passed / test_frames_count) << "%" << endl;
+    if (frames_drained >= 2) {
+        sc_time interval = (last_frame_done_time - first_frame_done_time) / double(frames_drained - 1);
+        cout << "Steady-state frame interval: " << interval << endl;
+    }
+    cout << "FFT configure transactions: " << fft_config_sent 
+         << " sent, " << fft_config_skipped << " skipped (cached)" << endl;
 }
 
 template <typename T>
 void FFT_Initiator<T>::compute_reference_results(const vector<complex<T>>& test_data) {
     vector<complex<float>> complex_test_data(test_data.begin(), test_data.end());
     vector<complex<float>> complex_reference = compute_reference_dft(complex_test_data);
-    frame_reference_data[current_frame_id] = vector<complex<T>>(complex_reference.begin(), 
-                                                                 complex_reference.end());
+    frame_arena.store(current_frame_id, FFTInitiatorUtils::FRAME_REFERENCE, complex_reference);
 }
 
 template <typename T>
 bool FFT_Initiator<T>::verify_frame_result(unsigned frame_id) {
-    if (frame_test_results.empty()) {
-        frame_test_results.resize(test_frames_count, false);
+    if (!frame_arena.resident(frame_id)) {
+        cout << "  ERROR: Frame " << frame_id << " has been retired from the frame arena" << endl;
+        return false;
     }
     
-    vector<complex<T>> fft_output = frame_output_data[frame_id];
-    vector<complex<T>> reference_dft = frame_reference_data[frame_id];
+    vector<complex<T>> fft_output = frame_arena.get(frame_id, FFTInitiatorUtils::FRAME_OUTPUT).to_vector();
+    vector<complex<T>> reference_dft = frame_arena.get(frame_id, FFTInitiatorUtils::FRAME_REFERENCE).to_vector();
     
     if (fft_output.size() != reference_dft.size()) {
         cout << "  ERROR: Size mismatch" << endl;
@@ -23,6 +23,8 @@
 #include "src/vcore/FFT_SA/utils/fft_test_utils.h"
 #include "src/vcore/FFT_SA/utils/complex_types.h"
 #include "FFT_initiator_utils.h"
+#include "FFT_plan.h"
+#include "FFT_frame_arena.h"
 #include <vector>
 #include <map>
 #include <iostream>
@@ -35,6 +37,27 @@ class FFTDecompositionManager {
     // Placeholder for potential future class-based management.
 };
 
+// Frame handed between the cross-frame pipeline stages: which frame and which AM slot holds it
+struct FramePipelineToken {
+    unsigned frame_id;
+    unsigned slot;
+    uint64_t result_addr;   // AM address of the computed frame (slot data or its corner-turn buffer)
+};
+inline ostream& operator<<(ostream& os, const FramePipelineToken& token) {
+    return os << "frame " << token.frame_id << " @slot " << token.slot;
+}
+
+// Test mode switches, set from the command line before the modules are instantiated (see testbench.cpp)
+struct FFTTestModes {
+    bool real_input = false;          // --real: real-valued frames, two packed per complex FFT
+    bool fast_convolution = false;    // --conv: overlap-save FIR filtering of each frame
+    bool pipelined_frames = false;    // --pipeline: overlap load/compute/drain of consecutive frames
+};
+inline FFTTestModes& fft_test_modes() {
+    static FFTTestModes modes;
+    return modes;
+}
+
 /**
  * @brief FFT_TLM Multi-Frame Test Initiator Class
  * 
@@ -48,7 +71,10 @@ struct FFT_Initiator : public BaseInitiatorModel<T> {
     using DecompositionInfo = FFTInitiatorUtils::DecompositionInfo;
     
     // ====== Constructor and SystemC Process Registration ======
-    SC_CTOR(FFT_Initiator) : BaseInitiatorModel<T>("FFT_Initiator") {
+    SC_CTOR(FFT_Initiator) : BaseInitiatorModel<T>("FFT_Initiator"),
+                             load_to_compute_fifo("load_to_compute_fifo", FRAME_PIPELINE_DEPTH),
+                             compute_to_drain_fifo("compute_to_drain_fifo", FRAME_PIPELINE_DEPTH),
+                             free_am_slots("free_am_slots", FRAME_PIPELINE_AM_SLOTS) {
         // Register main SystemC processes
         SC_THREAD(System_init_process);
         SC_THREAD(FFT_frame_loop_process);       // 帧循环主控制进程
@@ -60,6 +86,11 @@ struct FFT_Initiator : public BaseInitiatorModel<T> {
         SC_THREAD(FFT_single_frame_process);     // 单帧（直接模式）处理流程
         SC_THREAD(FFT_single_2D_process);        // 单帧（2D分解模式）处理流程
         //_THREAD(FFT_twiddle_process);          // 2D分解中的旋转因子补偿进程
+        
+        // Register cross-frame pipeline stages
+        SC_THREAD(FFT_frame_load_process);       // 帧N+1: 生成并DMA搬入AM
+        SC_THREAD(FFT_frame_compute_process);    // 帧N: AM中原地计算
+        SC_THREAD(FFT_frame_drain_process);      // 帧N-1: 写回DDR并验证
     }
 
 public:
@@ -113,10 +144,47 @@ public:
     unsigned M;                           // Total points for FFT (e.g., 16)
     unsigned single_frame_fft_size;      // Current single frame FFT size for hardware configuration
     unsigned last_configured_fft_size;   // Last configured FFT size to track changes
+    
+    // ====== FFT Configuration Cache ======
+    // Configuration currently loaded in FFT_TLM; a configure transaction is only sent when it changes
+    FFTInitiatorUtils::FFTConfigKey active_fft_config;
+    bool fft_config_valid = false;
+    map<size_t, FFTConfiguration> fft_config_by_size;   // Prebuilt configurations per transform size
+    unsigned fft_config_sent = 0;
+    unsigned fft_config_skipped = 0;
+
+    // ====== FFT Plan Cache ======
+    // One plan per transform size: decomposition tree, twiddle tables and leaf configurations built once
+    map<size_t, unique_ptr<FFTInitiatorUtils::FFTPlan>> fft_plans;
     bool use_2d_decomposition;            // Flag to control processing mode
+    bool use_out_of_core;                 // Frame exceeds AM: six-step FFT streaming panels from DDR
+    bool real_input_mode;                 // Real-valued frames, n/2+1 Hermitian output bins
+    bool real_pack_two_frames;            // Real mode: pack two frames into one complex FFT (else n/2-point FFT + post-twiddle)
+    bool fast_convolution_mode;           // Frames are filtered by overlap-save FFT -> multiply -> IFFT
+    size_t conv_filter_len;               // FIR taps in convolution mode
+    size_t conv_block_size;               // Overlap-save block (FFT) size
+    map<pair<unsigned, size_t>, vector<complex<float>>> conv_filter_spectra;  // (filter id, block size) -> spectrum
     int decomposition_level;              // 分解层级 (0: direct, 1: L1, 2: L2)
     bool frame_data_ready;                // Flag to indicate if frame data is ready
     
+    // ====== Cross-frame Pipeline ======
+    // load(N+1) / compute(N) / drain(N-1) run as separate processes joined by bounded FIFOs;
+    // AM frame slots are recycled through free_am_slots
+    static constexpr unsigned FRAME_PIPELINE_DEPTH = 2;     // Queue depth between stages
+    static constexpr unsigned FRAME_PIPELINE_AM_SLOTS = 3;  // At most triple-buffered AM frame slots
+    bool pipelined_frames;                // Enable the cross-frame pipeline
+    unsigned pipeline_am_slots;           // AM frame slots actually used (2 or 3)
+    sc_fifo<FramePipelineToken> load_to_compute_fifo;
+    sc_fifo<FramePipelineToken> compute_to_drain_fifo;
+    sc_fifo<unsigned> free_am_slots;
+    sc_event frame_pipeline_start_event;
+    sc_event frame_pipeline_done_event;
+    tlm_utils::tlm_quantumkeeper load_qk;    // Local time of the load stage (compute uses qk)
+    tlm_utils::tlm_quantumkeeper drain_qk;   // Local time of the drain stage
+    unsigned frames_drained;                 // Frames completed by the drain stage
+    sc_time first_frame_done_time;           // Drain completion of the first and latest frame
+    sc_time last_frame_done_time;
+    
     // ====== 2D FFT Decomposition State Variables ======
     // These are used by the 2D process to track its internal state
     unsigned current_column_id;            // Current column being processed in 2D FFT
@@ -125,20 +193,19 @@ public:
     unsigned N1, N2;                       // 2D decomposition parameters (N1=rows, N2=cols)
     
     // ====== Test Data Management ======
-    // Multi-frame test data storage
-    map<unsigned, vector<complex<T>>> frame_input_data;   // Input data: frame_id -> input_data
-    map<unsigned, vector<complex<T>>> frame_output_data;  // Output data: frame_id -> output_data
-    map<unsigned, vector<complex<T>>> frame_reference_data; // Reference data: frame_id -> reference_dft
+    // Input / reference / output buffers of the frames in flight, in a ring of arena slots
+    // (frame f in slot f % slots); older frames are retired, so memory is independent of frame count
+    static constexpr unsigned FRAME_ARENA_SLOTS = 8;   // Pipelined ring: > AM slots in flight + the frame being verified
+    FFTInitiatorUtils::FrameArena<T> frame_arena;
     
     // ====== 2D FFT Decomposition Intermediate Data ======
-    // 2D decomposition intermediate data storage (per frame)
-    map<unsigned, vector<vector<complex<T>>>> frame_data_matrix;  // Reshaped input matrix: frame_id -> matrix[row][col]
-    map<unsigned, vector<vector<complex<T>>>> frame_G_matrix;     // Column FFT results: frame_id -> G_matrix[row][col]
-    map<unsigned, vector<vector<complex<T>>>> frame_H_matrix;     // Twiddle compensated: frame_id -> H_matrix[row][col]  
-    map<unsigned, vector<vector<complex<T>>>> frame_X_matrix;     // Row FFT results: frame_id -> X_matrix[row][col]
+    // G (column FFTs), H (twiddle compensated) and X (row FFTs) as N2 x N1 views over one flat buffer (current frame)
+    FFTInitiatorUtils::aligned_vector<complex<T>> work_2d;
+    FFTInitiatorUtils::MatrixView<complex<T>> G_matrix;
+    FFTInitiatorUtils::MatrixView<complex<T>> H_matrix;
+    FFTInitiatorUtils::MatrixView<complex<T>> X_matrix;
     
     // Test result statistics
-    vector<bool> frame_test_results;      // Test result for each frame
     int total_frames_tested;              // Total number of frames tested
     int frames_passed;                    // Number of frames that passed
     int frames_failed;                    // Number of frames that failed
@@ -163,6 +230,12 @@ private:
     void FFT_single_frame_process();
     void FFT_single_2D_process();
     
+    // ====== Cross-frame Pipeline Process Declarations ======
+    void FFT_frame_load_process();
+    void FFT_frame_compute_process();
+    void FFT_frame_drain_process();
+    uint64_t pipeline_slot_address(unsigned slot) const;
+    
     // ====== 2D FFT Decomposition Process Declarations ======
     //void FFT_twiddle_process();
     
@@ -179,19 +252,30 @@ private:
     void process_frame_direct_mode();
     void process_frame_level1_mode();
     void process_frame_level2_mode();
-    void execute_level1_2d_fft();
-    void execute_level2_2d_fft(size_t L2_N1, size_t L2_N2);
-    vector<complex<float>> perform_adaptive_fft(const vector<complex<float>>& input, size_t fft_size);
-    vector<complex<float>> perform_level1_2d_fft_internal(const vector<complex<float>>& input, size_t n1, size_t n2, size_t total_size);
-    void process_level1_column_fft();
-    void process_level1_twiddle();
-    void process_level1_row_fft();
+    FFTInitiatorUtils::FFTPlan& get_fft_plan(size_t fft_size);
+    void execute_planned_fft(FFTInitiatorUtils::FFTPlan& plan);
+    // Runs a plan on a frame in AM. A Cooley-Tukey root is executed as column FFTs / row FFTs
+    // with DMA transposes (corner turns) in AM in between; returns the AM address of the
+    // natural-order result (data_addr or scratch_addr, scratch holds n points)
+    uint64_t execute_corner_turn_fft(FFTInitiatorUtils::FFTPlan& plan, uint64_t data_addr, uint64_t scratch_addr);
+    void process_frame_six_step_mode();
+    bool process_frame_real_mode();
+    void process_frame_convolution_mode();
+    const vector<complex<float>>& get_filter_spectrum(unsigned filter_id, const vector<complex<float>>& taps, size_t block_size);
+    void run_fast_convolution(unsigned filter_id, const vector<complex<float>>& taps,
+                              uint64_t ddr_in_addr, uint64_t ddr_out_addr, size_t signal_len);
+    void execute_six_step_fft(uint64_t ddr_data_addr, uint64_t ddr_out_addr);
+    // Double-buffered AM panel loop: load(p+1) overlaps compute(p) and store(p-1)
+    using PanelDma = std::function<void(size_t panel, unsigned slot, ins::dma_nb_handle& handle)>;
+    using PanelCompute = std::function<void(size_t panel, unsigned slot)>;
+    void run_panel_pipeline(size_t panel_num, const PanelDma& load, const PanelCompute& compute, const PanelDma& store);
     // void display_frame_result(unsigned frame_id);
     void display_final_statistics();
 
     // Data generation and movement helpers
     bool should_reconfigure_fft();
     void reconfigure_fft_hardware();
+    bool apply_fft_configuration(const FFTConfiguration& config);
     vector<complex<T>> generate_frame_test_data();
     void prepare_frame_data_once();
     void perform_data_movement(const vector<complex<T>>& test_data);
@@ -212,6 +296,15 @@ private:
     void compute_reference_results(const vector<complex<T>>& test_data);
     bool verify_frame_result(unsigned frame_id);
     vector<complex<float>> perform_fft_core(const vector<complex<float>>& input, size_t fft_size);
+    
+    // Batched FFT: howmany transforms of fft_size points, element i of transform b
+    // read from in[b*idist + i*istride] and written (natural order) to out[b*odist + i*ostride],
+    // optionally multiplied by post[b*odist + i*ostride] on the way out (fused twiddle)
+    void configure_fft_size(size_t fft_size);
+    void perform_fft_batch(size_t fft_size, size_t howmany,
+                           const complex<float>* in, size_t istride, size_t idist,
+                           complex<float>* out, size_t ostride, size_t odist,
+                           const complex<float>* post = nullptr);
     void perform_final_verification();
     
     // moved to utils: compute_twiddle_factor, reshape helpers
@@ -3,21 +3,56 @@
  */
 
 #include "FFT_initiator_utils.h"
+#include <map>
+#include <algorithm>
+#include <numeric>
 
 using namespace std;
 
 namespace FFTInitiatorUtils {
 
+bool is_supported_leaf_size(size_t size, size_t base_n) {
+    return size >= 1 && size <= base_n && (size & (size - 1)) == 0;
+}
+
 DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n) {
     DecompositionInfo info;
     info.total_points = fft_size;
     info.is_valid = false;
 
-    if (fft_size <= base_n) {
+    if (is_supported_leaf_size(fft_size, base_n)) {
         info.level = 0;
         info.is_valid = true;
         return info;
     }
+    // Sizes that are not a product of supported leaf sizes (odd or non-power-of-two, large or small)
+    // always run through a plan rather than the direct path, so their level is at least 1
+    if (fft_size >= 2 && !can_decompose_recursive(fft_size, base_n)) {
+        // Prime factor: power-of-two leaf x odd remainder, e.g. 240 = 16 x 15, no twiddle pass
+        auto coprime = find_coprime_level1_decomposition(fft_size, base_n);
+        if (coprime.first != 0) {
+            DecompositionInfo odd = analyze_decomposition_strategy(coprime.second, base_n);
+            if (odd.is_valid) {
+                info.level = 1 + odd.level;
+                info.level_dims.emplace_back(coprime.first, coprime.second);
+                info.level_dims.insert(info.level_dims.end(), odd.level_dims.begin(), odd.level_dims.end());
+                info.is_valid = true;
+                return info;
+            }
+        }
+        // Bluestein: power-of-two convolution (m >= 2n - 1)
+        size_t m = 1;
+        while (m < 2 * fft_size - 1) m <<= 1;
+        DecompositionInfo conv = analyze_decomposition_strategy(m, base_n);
+        if (conv.is_valid) {
+            info.level = max(conv.level, 1);
+            info.level_dims = conv.level_dims;
+            info.bluestein_size = m;
+            info.is_valid = true;
+        }
+        return info;
+    }
+
     // if (fft_size == 32 ) {
     //     cout << "DEBUG: fft_size == 32" << endl;
     //     info.level = 1;
@@ -31,7 +66,7 @@ DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n)
         for (size_t n1 = base_n; n1 >= 2; n1--) {
             if (fft_size % n1 == 0) {
                 size_t n2 = fft_size / n1;
-                if (n2 <= base_n) {
+                if (is_supported_leaf_size(n1, base_n) && is_supported_leaf_size(n2, base_n)) {
                     info.level = 1;
                     info.level_dims.emplace_back(n1, n2);
                     info.is_valid = true;
@@ -42,7 +77,7 @@ DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n)
         }
         // square fallback
         size_t sqrt_size = static_cast<size_t>(sqrt(fft_size));
-        if (sqrt_size * sqrt_size == fft_size && sqrt_size <= base_n) {
+        if (sqrt_size * sqrt_size == fft_size && is_supported_leaf_size(sqrt_size, base_n)) {
             info.level = 1;
             info.level_dims.emplace_back(sqrt_size, sqrt_size);
             info.is_valid = true;
@@ -65,8 +100,8 @@ DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n)
         for (auto& cand : candidates) {
             size_t n1 = cand.first;
             size_t n2 = cand.second;
-            bool n1_ok = (n1 <= base_n) || (n1 <= level1_max && can_decompose_level1(n1, base_n));
-            bool n2_ok = (n2 <= base_n) || (n2 <= level1_max && can_decompose_level1(n2, base_n));
+            bool n1_ok = is_supported_leaf_size(n1, base_n) || (n1 <= level1_max && can_decompose_level1(n1, base_n));
+            bool n2_ok = is_supported_leaf_size(n2, base_n) || (n2 <= level1_max && can_decompose_level1(n2, base_n));
             if (n1_ok && n2_ok) {
                 info.level = 2;
                 info.level_dims.emplace_back(n2, n1); // row x col (N2 x N1)
@@ -78,15 +113,47 @@ DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n)
         }
     }
 
+    // Level 3+: recursive split n = n1 * n2 with n1 the largest divisor <= sqrt(n),
+    // each factor decomposed again until it fits the hardware
+    if (fft_size > level1_max && can_decompose_recursive(fft_size, base_n)) {
+        size_t n1 = static_cast<size_t>(sqrt(static_cast<double>(fft_size)));
+        while (fft_size % n1 != 0) n1--;
+        size_t n2 = fft_size / n1;
+        DecompositionInfo sub1 = analyze_decomposition_strategy(n1, base_n);
+        DecompositionInfo sub2 = analyze_decomposition_strategy(n2, base_n);
+        if (sub1.is_valid && sub2.is_valid) {
+            info.level = 1 + max(sub1.level, sub2.level);
+            info.level_dims.emplace_back(n2, n1); // row x col (N2 x N1)
+            // deeper levels follow the larger factor
+            info.level_dims.insert(info.level_dims.end(), sub2.level_dims.begin(), sub2.level_dims.end());
+            info.is_valid = true;
+        }
+    }
+
     return info;
 }
 
+pair<size_t, size_t> find_coprime_level1_decomposition(size_t size, size_t base_n) {
+    if (size < 2) return make_pair(size_t(0), size_t(0));
+    // the only power of two coprime to the remainder is the whole power-of-two part
+    size_t n1 = size & (~size + 1);
+    size_t n2 = size / n1;
+    if (n1 >= 2 && n2 >= 2 && is_supported_leaf_size(n1, base_n)) return make_pair(n1, n2);
+    return make_pair(size_t(0), size_t(0));
+}
+
+bool can_decompose_recursive(size_t size, size_t base_n) {
+    if (size < 2 || base_n < 2) return false;
+    // supported leaves are powers of two, so exactly the powers of two split into them
+    return (size & (size - 1)) == 0;
+}
+
 bool can_decompose_level1(size_t size, size_t base_n) {
-    if (size <= base_n) return true;
+    if (is_supported_leaf_size(size, base_n)) return true;
     for (size_t n1 = base_n; n1 >= 1; n1--) {
         if (size % n1 == 0) {
             size_t n2 = size / n1;
-            if (n2 <= base_n) return true;
+            if (is_supported_leaf_size(n1, base_n) && is_supported_leaf_size(n2, base_n)) return true;
         }
         if (n1 == 1) break; // prevent wrap
     }
@@ -97,7 +164,7 @@ pair<size_t, size_t> find_level1_decomposition(size_t size, size_t base_n) {
     for (size_t n1 = base_n; n1 >= 1; n1--) {
         if (size % n1 == 0) {
             size_t n2 = size / n1;
-            if (n2 <= base_n) return make_pair(n1, n2);
+            if (is_supported_leaf_size(n1, base_n) && is_supported_leaf_size(n2, base_n)) return make_pair(n1, n2);
         }
         if (n1 == 1) break; // prevent wrap
     }
@@ -106,8 +173,37 @@ pair<size_t, size_t> find_level1_decomposition(size_t size, size_t base_n) {
 }
 
 complex<float> compute_twiddle_factor(int k2, int n1, int N) {
-    float angle = -2.0f * static_cast<float>(M_PI) * k2 * n1 / N;
-    return complex<float>(cos(angle), sin(angle));
+    return twiddle_table(N)[(static_cast<uint64_t>(k2) * n1) % N];
+}
+
+const vector<complex<float>>& twiddle_table(size_t N) {
+    static map<size_t, vector<complex<float>>> tables;
+    auto it = tables.find(N);
+    if (it != tables.end()) return it->second;
+
+    vector<complex<float>> table(N);
+    for (size_t k = 0; k < N; k++) {
+        double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(N);
+        table[k] = complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+    return tables.emplace(N, std::move(table)).first->second;
+}
+
+const vector<complex<float>>& compensation_twiddles(size_t rows, size_t cols) {
+    static map<pair<size_t, size_t>, vector<complex<float>>> tables;
+    auto key = make_pair(rows, cols);
+    auto it = tables.find(key);
+    if (it != tables.end()) return it->second;
+
+    size_t N = rows * cols;
+    const vector<complex<float>>& W = twiddle_table(N);
+    vector<complex<float>> table(N);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            table[r * cols + c] = W[(r * c) % N];
+        }
+    }
+    return tables.emplace(key, std::move(table)).first->second;
 }
 
 FFTConfiguration create_fft_configuration(size_t hw_size, size_t real_size) {
@@ -133,13 +229,58 @@ FFTConfiguration create_fft_configuration(size_t hw_size, size_t real_size) {
 
 
 
+FFTConfigKey make_config_key(const FFTConfiguration& config) {
+    FFTConfigKey key;
+    key.fft_mode = config.fft_mode;
+    key.fft_conj_en = config.fft_conj_en;
+    key.fft_shift = static_cast<long>(config.fft_shift);
+    key.fft_size = config.fft_size;
+    key.fft_size_real = config.fft_size_real;
+    for (size_t i = 0; i < config.stage_bypass_en.size() && i < 64; i++) {
+        if (config.stage_bypass_en[i]) key.bypass_mask |= (1ULL << i);
+    }
+    return key;
+}
+
 //访存相关
 uint64_t calculate_ddr_address(unsigned frame_id, unsigned test_fft_size, uint64_t ddr_base_addr) {
     return ddr_base_addr + static_cast<uint64_t>(frame_id) * test_fft_size * sizeof(complex<float>) * 2ULL;
 }
 
-uint64_t calculate_am_address(unsigned frame_id, unsigned test_fft_size, uint64_t am_base_addr) {
-    return am_base_addr + static_cast<uint64_t>(frame_id) * test_fft_size * sizeof(complex<float>) * 2ULL;
+uint64_t calculate_am_address(unsigned frame_id, unsigned test_fft_size, uint64_t am_base_addr, uint64_t am_size) {
+    uint64_t frame_bytes = static_cast<uint64_t>(test_fft_size) * sizeof(complex<float>) * 2ULL;
+    uint64_t slots = std::max<uint64_t>(1, am_size / frame_bytes);
+    return am_base_addr + (frame_id % slots) * frame_bytes;
+}
+
+bool frame_fits_am(unsigned test_fft_size, uint64_t am_size) {
+    return static_cast<uint64_t>(test_fft_size) * sizeof(complex<float>) * 2ULL <= am_size;
+}
+
+SixStepLayout make_six_step_layout(size_t fft_size, size_t am_elems) {
+    SixStepLayout layout;
+    layout.buffer_elems = am_elems / 4;   // 2 slots x (panel + transposed panel)
+
+    // near-square split with n2 <= n1
+    size_t n2 = static_cast<size_t>(sqrt(static_cast<double>(fft_size)));
+    while (n2 > 1 && fft_size % n2 != 0) n2--;
+    size_t n1 = fft_size / n2;
+    if (n2 < 2 || n1 > layout.buffer_elems) {
+        return layout;
+    }
+
+    // panels must tile the matrix exactly
+    size_t col_panel = layout.buffer_elems / n2;
+    while (n1 % col_panel != 0) col_panel--;
+    size_t row_panel = layout.buffer_elems / n1;
+    while (n2 % row_panel != 0) row_panel--;
+
+    layout.n1 = n1;
+    layout.n2 = n2;
+    layout.col_panel = col_panel;
+    layout.row_panel = row_panel;
+    layout.is_valid = true;
+    return layout;
 }
 
 } // namespace FFTInitiatorUtils
@@ -24,50 +24,165 @@ struct DecompositionInfo {
     std::vector<std::pair<size_t, size_t>> level_dims;     // per-level dims
     bool is_valid = false;
     std::vector<std::pair<size_t, size_t>> sub_decompositions; // optional
+    size_t bluestein_size = 0;     // non-zero: no hardware factorization, run as a Bluestein convolution of this size
 };
 
 // Decomposition helpers (independent of class state)
+// Sizes the hardware FFT runs directly: powers of two up to base_n (stages are bypassed via log2)
+bool is_supported_leaf_size(size_t size, size_t base_n);
 DecompositionInfo analyze_decomposition_strategy(size_t fft_size, size_t base_n);
 bool can_decompose_level1(size_t size, size_t base_n);
 std::pair<size_t, size_t> find_level1_decomposition(size_t size, size_t base_n);
+// Coprime split (n1, n2): n1 the power-of-two part of size as a supported leaf, n2 >= 2 the odd
+// remainder (itself run as any sub-plan, e.g. Bluestein); (0, 0) if none.
+// Such splits allow the twiddle-free Good-Thomas mapping.
+std::pair<size_t, size_t> find_coprime_level1_decomposition(size_t size, size_t base_n);
+// True if size is a product of supported leaf sizes, i.e. a Cooley-Tukey tree of hardware FFTs exists
+bool can_decompose_recursive(size_t size, size_t base_n);
 
 // Twiddle helper
 complex<float> compute_twiddle_factor(int k2, int n1, int N);
 
-// Matrix reshape helpers (header-only templates)
+// Twiddle cache: process-wide tables built once per size in double precision and stored as float.
+// twiddle_table(N)[k] = W_N^k, k = 0..N-1
+const std::vector<complex<float>>& twiddle_table(size_t N);
+// compensation_twiddles(rows, cols)[r * cols + c] = W_(rows*cols)^(r*c), the 2D decomposition twiddles
+const std::vector<complex<float>>& compensation_twiddles(size_t rows, size_t cols);
+
+// ====== Strided views (header-only templates) ======
+// Non-owning views over flat buffers, so 2D/3D decompositions index in place instead of
+// reshaping into nested vectors. A view of a column is just (pointer, stride).
+
+// Element i at data[i * stride]
+template <typename T>
+struct StridedView {
+    T* data = nullptr;
+    size_t size = 0;
+    size_t stride = 1;
+
+    T& operator[](size_t i) const { return data[i * stride]; }
+};
+
+// Element (r, c) at data[r * row_stride + c * col_stride]
+template <typename T>
+struct MatrixView {
+    T* data = nullptr;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t row_stride = 0;
+    size_t col_stride = 1;
+
+    T& operator()(size_t r, size_t c) const { return data[r * row_stride + c * col_stride]; }
+    StridedView<T> row(size_t r) const { return StridedView<T>{data + r * row_stride, cols, col_stride}; }
+    StridedView<T> col(size_t c) const { return StridedView<T>{data + c * col_stride, rows, row_stride}; }
+    // Same elements with rows and columns swapped, no data movement
+    MatrixView transposed() const { return MatrixView{data, cols, rows, col_stride, row_stride}; }
+    MatrixView block(size_t r0, size_t c0, size_t nr, size_t nc) const {
+        return MatrixView{data + r0 * row_stride + c0 * col_stride, nr, nc, row_stride, col_stride};
+    }
+    size_t size() const { return rows * cols; }
+};
+
+// Element (p, r, c) at data[p * plane_stride + r * row_stride + c * col_stride]
 template <typename T>
-inline std::vector<std::vector<complex<T>>> reshape_to_matrix(const std::vector<complex<T>>& input,
-                                                              int rows, int cols) {
-    if (rows <= 0 || cols <= 0 || input.size() != static_cast<size_t>(rows * cols)) {
-        return std::vector<std::vector<complex<T>>>(rows, std::vector<complex<T>>(cols, complex<T>(0, 0)));
+struct Tensor3View {
+    T* data = nullptr;
+    size_t planes = 0;
+    size_t rows = 0;
+    size_t cols = 0;
+    size_t plane_stride = 0;
+    size_t row_stride = 0;
+    size_t col_stride = 1;
+
+    T& operator()(size_t p, size_t r, size_t c) const {
+        return data[p * plane_stride + r * row_stride + c * col_stride];
+    }
+    MatrixView<T> plane(size_t p) const {
+        return MatrixView<T>{data + p * plane_stride, rows, cols, row_stride, col_stride};
     }
-    std::vector<std::vector<complex<T>>> matrix(rows, std::vector<complex<T>>(cols));
-    for (int i = 0; i < static_cast<int>(input.size()); ++i) {
-        matrix[i / cols][i % cols] = input[i];
+    // Fibre along the plane axis at (r, c)
+    StridedView<T> tube(size_t r, size_t c) const {
+        return StridedView<T>{data + r * row_stride + c * col_stride, planes, plane_stride};
     }
-    return matrix;
+    size_t size() const { return planes * rows * cols; }
+};
+
+// Row-major rows x cols view: x[r * cols + c]. For a 2D decomposition of x[n1*j2 + j1]
+// that is the N2 x N1 matrix with column j1 = col(j1) and row j2 = row(j2)
+template <typename T>
+inline MatrixView<T> matrix_view(T* data, size_t rows, size_t cols) {
+    return MatrixView<T>{data, rows, cols, cols, 1};
 }
 
+// Row-major planes x rows x cols view: x[(p * rows + r) * cols + c]
 template <typename T>
-inline std::vector<complex<T>> reshape_to_vector(const std::vector<std::vector<complex<T>>>& matrix) {
-    if (matrix.empty() || matrix[0].empty()) {
-        return std::vector<complex<T>>();
+inline Tensor3View<T> tensor3_view(T* data, size_t planes, size_t rows, size_t cols) {
+    return Tensor3View<T>{data, planes, rows, cols, rows * cols, cols, 1};
+}
+
+// FFT_TLM output order: the first n/2 outputs are the even bins, the last n/2 the odd bins.
+// Writes the n bins of one transform to out in natural order with stride ostride.
+template <typename Tin, typename Tout>
+inline void hw_output_to_natural(const complex<Tin>* hw, complex<Tout>* out, size_t n, size_t ostride = 1) {
+    for (size_t k = 0; k < n; ++k) {
+        const complex<Tin>& v = (k % 2 == 0) ? hw[k / 2] : hw[n / 2 + k / 2];
+        out[k * ostride] = complex<Tout>(v.real, v.imag);
+    }
+}
+
+// Same reorder with bin k multiplied by twiddle[k * ostride] on the way out (fused twiddle stage)
+inline void hw_output_to_natural(const complex<float>* hw, complex<float>* out, size_t n, size_t ostride,
+                                 const complex<float>* twiddle) {
+    if (!twiddle) {
+        hw_output_to_natural(hw, out, n, ostride);
+        return;
     }
-    std::vector<complex<T>> output;
-    output.reserve(matrix.size() * matrix[0].size());
-    for (const auto& row : matrix) {
-        for (const auto& val : row) output.push_back(val);
+    for (size_t k = 0; k < n; ++k) {
+        const complex<float>& v = (k % 2 == 0) ? hw[k / 2] : hw[n / 2 + k / 2];
+        out[k * ostride] = v * twiddle[k * ostride];
     }
-    return output;
 }
 
 // Config helper
 FFTConfiguration create_fft_configuration(size_t hw_size, size_t real_size);
 
+// Full FFT_TLM configuration state, compared before sending a configure transaction
+struct FFTConfigKey {
+    bool fft_mode = false;
+    bool fft_conj_en = false;
+    long fft_shift = 0;
+    size_t fft_size = 0;
+    size_t fft_size_real = 0;
+    uint64_t bypass_mask = 0;   // bit i = stage_bypass_en[i]
+
+    bool operator==(const FFTConfigKey& other) const {
+        return fft_mode == other.fft_mode && fft_conj_en == other.fft_conj_en &&
+               fft_shift == other.fft_shift && fft_size == other.fft_size &&
+               fft_size_real == other.fft_size_real && bypass_mask == other.bypass_mask;
+    }
+    bool operator!=(const FFTConfigKey& other) const { return !(*this == other); }
+};
+FFTConfigKey make_config_key(const FFTConfiguration& config);
+
 // Addressing helpers
 
 uint64_t calculate_ddr_address(unsigned frame_id, unsigned test_fft_size, uint64_t ddr_base_addr);
-uint64_t calculate_am_address(unsigned frame_id, unsigned test_fft_size, uint64_t am_base_addr);
+// Frames (data + twiddles) reuse as many slots as fit in am_size; frames that do not fit at all
+// must go through the out-of-core path (see make_six_step_layout)
+uint64_t calculate_am_address(unsigned frame_id, unsigned test_fft_size, uint64_t am_base_addr, uint64_t am_size);
+bool frame_fits_am(unsigned test_fft_size, uint64_t am_size);
+
+// Out-of-core six-step FFT: the n2 x n1 matrix stays in DDR and panels stream through AM.
+// AM is split into two ping-pong slots, each holding a panel buffer and its transposed copy.
+struct SixStepLayout {
+    size_t n1 = 0;              // row length, transformed in the row pass
+    size_t n2 = 0;              // column length, transformed in the column pass
+    size_t col_panel = 0;       // columns per AM panel in the column pass
+    size_t row_panel = 0;       // rows per AM panel in the row pass
+    size_t buffer_elems = 0;    // capacity of one AM buffer in complex elements
+    bool is_valid = false;
+};
+SixStepLayout make_six_step_layout(size_t fft_size, size_t am_elems);
 
 } // namespace FFTInitiatorUtils
 
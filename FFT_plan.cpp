@@ -0,0 +1,309 @@
+/**
+ * @file FFT_plan.cpp
+ */
+
+#include "FFT_plan.h"
+#include <algorithm>
+#include <numeric>
+#include <map>
+#include <cmath>
+
+using namespace std;
+
+namespace FFTInitiatorUtils {
+
+// a^-1 mod m for coprime a, m (linear search, run once per plan build)
+static size_t mod_inverse(size_t a, size_t m) {
+    if (m == 1) return 0;
+    for (size_t x = 1; x < m; x++) {
+        if (a * x % m == 1) return x;
+    }
+    return 0;
+}
+
+// Bluestein chirp w[j] = exp(-i*pi*j^2/n), j^2 reduced mod 2n before the double-precision angle
+static const vector<complex<float>>& bluestein_chirp(size_t n) {
+    static map<size_t, vector<complex<float>>> tables;
+    auto it = tables.find(n);
+    if (it != tables.end()) return it->second;
+
+    vector<complex<float>> chirp(n);
+    for (size_t j = 0; j < n; j++) {
+        double angle = -M_PI * static_cast<double>((j * j) % (2 * n)) / static_cast<double>(n);
+        chirp[j] = complex<float>(static_cast<float>(std::cos(angle)), static_cast<float>(std::sin(angle)));
+    }
+    return tables.emplace(n, std::move(chirp)).first->second;
+}
+
+// Chirp spectra are computed once per size (on the leaf executor) and shared by every plan
+static map<size_t, vector<complex<float>>>& bluestein_spectrum_cache() {
+    static map<size_t, vector<complex<float>>> spectra;
+    return spectra;
+}
+
+FFTPlan::FFTPlan(size_t n, size_t base_n, FFTLeafExecutor leaf)
+    : n_(n), base_n_(base_n), leaf_(std::move(leaf)) {
+    root_ = build(n);
+    if (!root_) leaf_sizes_.clear();
+}
+
+unique_ptr<FFTPlanNode> FFTPlan::build(size_t n) {
+    auto node = unique_ptr<FFTPlanNode>(new FFTPlanNode());
+    node->n = n;
+
+    if (is_supported_leaf_size(n, base_n_)) {
+        node->kind = FFTPlanNode::LEAF;
+        if (find(leaf_sizes_.begin(), leaf_sizes_.end(), n) == leaf_sizes_.end()) {
+            leaf_sizes_.push_back(n);
+        }
+        return node;
+    }
+
+    DecompositionInfo info = analyze_decomposition_strategy(n, base_n_);
+    if (info.is_valid && info.bluestein_size != 0) {
+        return build_bluestein(std::move(node), info.bluestein_size);
+    }
+    if (!info.is_valid || info.level_dims.empty()) {
+        return nullptr;
+    }
+    // 互质拆分（2的幂叶子 x 奇数余因子）走无旋转因子的素因子分解，奇数列子计划可为Bluestein
+    size_t n1 = info.level_dims[0].first;
+    size_t n2 = info.level_dims[0].second;
+    node->n1 = n1;
+    node->n2 = n2;
+    node->col = build(n2);
+    node->row = build(n1);
+    if (!node->col || !node->row) {
+        return nullptr;
+    }
+    node->scratch.resize(n);
+
+    if (gcd(n1, n2) == 1) {
+        node->kind = FFTPlanNode::PRIME_FACTOR;
+        // CRT: e1 = 1 (mod n1), 0 (mod n2); e2 = 0 (mod n1), 1 (mod n2)
+        size_t e1 = n2 * mod_inverse(n2 % n1, n1) % n;
+        size_t e2 = n1 * mod_inverse(n1 % n2, n2) % n;
+        node->input_map.resize(n);
+        node->output_map.resize(n);
+        for (size_t j2 = 0; j2 < n2; j2++) {
+            for (size_t j1 = 0; j1 < n1; j1++) {
+                node->input_map[j2 * n1 + j1] = (j1 * n2 + j2 * n1) % n;
+                node->output_map[j2 * n1 + j1] = (j1 * e1 + j2 * e2) % n;
+            }
+        }
+    } else {
+        node->kind = FFTPlanNode::COOLEY_TUKEY;
+        node->twiddles = &compensation_twiddles(n2, n1);
+    }
+    return node;
+}
+
+unique_ptr<FFTPlanNode> FFTPlan::build_bluestein(unique_ptr<FFTPlanNode> node, size_t m) {
+    const size_t n = node->n;
+    node->kind = FFTPlanNode::BLUESTEIN;
+    node->conv_n = m;
+    node->col = build(m);
+    if (!node->col) {
+        return nullptr;
+    }
+    node->scratch.resize(m);
+    node->chirp = &bluestein_chirp(n);
+
+    auto& spectra = bluestein_spectrum_cache();
+    auto it = spectra.find(n);
+    if (it == spectra.end()) {
+        // b[j] = conj(w[j]) for |j| < n (wrapped), zero elsewhere; 1/m of the inverse FFT folded in
+        const auto& w = *node->chirp;
+        vector<complex<float>> b(m, complex<float>(0, 0));
+        b[0] = complex<float>(w[0].real, -w[0].imag);
+        for (size_t j = 1; j < n; j++) {
+            b[j] = b[m - j] = complex<float>(w[j].real, -w[j].imag);
+        }
+        run(*node->col, 1, b.data(), 1, m, b.data(), 1, m);
+        const float scale = 1.0f / static_cast<float>(m);
+        for (auto& v : b) {
+            v = complex<float>(v.real * scale, v.imag * scale);
+        }
+        it = spectra.emplace(n, std::move(b)).first;
+    }
+    node->chirp_spectrum = &it->second;
+    return node;
+}
+
+void FFTPlan::execute(const complex<float>* in, complex<float>* out) {
+    execute_batch(1, in, 1, n_, out, 1, n_);
+}
+
+void FFTPlan::execute_batch(size_t howmany,
+                            const complex<float>* in, size_t istride, size_t idist,
+                            complex<float>* out, size_t ostride, size_t odist,
+                            const complex<float>* post) {
+    if (!root_) {
+        std::cout << "ERROR: executing an invalid FFT plan (" << n_ << " points)" << std::endl;
+        return;
+    }
+    run(*root_, howmany, in, istride, idist, out, ostride, odist, post);
+}
+
+void FFTPlan::execute_inverse(const complex<float>* in, complex<float>* out) {
+    execute_batch_inverse(1, in, 1, n_, out, 1, n_);
+}
+
+void FFTPlan::execute_batch_inverse(size_t howmany,
+                                    const complex<float>* in, size_t istride, size_t idist,
+                                    complex<float>* out, size_t ostride, size_t odist) {
+    if (!root_) {
+        std::cout << "ERROR: executing an invalid FFT plan (" << n_ << " points)" << std::endl;
+        return;
+    }
+    inverse_scratch_.resize(n_);
+    complex<float>* s = inverse_scratch_.data();
+    const float scale = 1.0f / static_cast<float>(n_);
+    for (size_t b = 0; b < howmany; b++) {
+        const complex<float>* x = in + b * idist;
+        complex<float>* X = out + b * odist;
+        for (size_t i = 0; i < n_; i++) {
+            s[i] = complex<float>(x[i * istride].real, -x[i * istride].imag);
+        }
+        run(*root_, 1, s, 1, n_, X, ostride, n_ * ostride);
+        for (size_t k = 0; k < n_; k++) {
+            complex<float>& v = X[k * ostride];
+            v = complex<float>(v.real * scale, -v.imag * scale);
+        }
+    }
+}
+
+void FFTPlan::run(FFTPlanNode& node, size_t howmany,
+                  const complex<float>* in, size_t istride, size_t idist,
+                  complex<float>* out, size_t ostride, size_t odist,
+                  const complex<float>* post) {
+    if (node.kind == FFTPlanNode::LEAF) {
+        leaf_(node.n, howmany, in, istride, idist, out, ostride, odist, post);
+        return;
+    }
+
+    const size_t n1 = node.n1;
+    const size_t n2 = node.n2;
+    complex<float>* s = node.scratch.data();
+
+    if (node.kind == FFTPlanNode::BLUESTEIN) {
+        const size_t n = node.n;
+        const size_t m = node.conv_n;
+        const complex<float>* w = node.chirp->data();
+        const complex<float>* B = node.chirp_spectrum->data();
+        for (size_t b = 0; b < howmany; b++) {
+            const complex<float>* x = in + b * idist;
+            complex<float>* X = out + b * odist;
+            // Chirp premultiply, zero-padded to m
+            for (size_t j = 0; j < n; j++) {
+                s[j] = x[j * istride] * w[j];
+            }
+            for (size_t j = n; j < m; j++) {
+                s[j] = complex<float>(0, 0);
+            }
+            run(*node.col, 1, s, 1, m, s, 1, m);
+            // Pointwise multiply with the chirp spectrum; the inverse FFT is conj(FFT(conj(.)))
+            for (size_t k = 0; k < m; k++) {
+                complex<float> v = s[k] * B[k];
+                s[k] = complex<float>(v.real, -v.imag);
+            }
+            run(*node.col, 1, s, 1, m, s, 1, m);
+            // Chirp postmultiply, with the caller's twiddle fused in
+            const complex<float>* P = post ? post + b * odist : nullptr;
+            for (size_t k = 0; k < n; k++) {
+                complex<float> v = w[k] * complex<float>(s[k].real, -s[k].imag);
+                X[k * ostride] = P ? v * P[k * ostride] : v;
+            }
+        }
+        return;
+    }
+
+    if (node.kind == FFTPlanNode::PRIME_FACTOR) {
+        const size_t* imap = node.input_map.data();
+        const size_t* omap = node.output_map.data();
+        for (size_t b = 0; b < howmany; b++) {
+            const complex<float>* x = in + b * idist;
+            complex<float>* X = out + b * odist;
+            // Input permutation into the n2 x n1 matrix
+            for (size_t i = 0; i < node.n; i++) {
+                s[i] = x[imap[i] * istride];
+            }
+            // Column and row FFTs in place, no twiddle stage
+            run(*node.col, n1, s, n1, 1, s, n1, 1);
+            run(*node.row, n2, s, 1, n1, s, 1, n1);
+            // Output permutation, with the caller's twiddle fused in
+            const complex<float>* P = post ? post + b * odist : nullptr;
+            for (size_t i = 0; i < node.n; i++) {
+                X[omap[i] * ostride] = P ? s[i] * P[omap[i] * ostride] : s[i];
+            }
+        }
+        return;
+    }
+
+    // The twiddle table is laid out like the column output s[k2*n1 + j1], so the
+    // compensation W_n^(k2*j1) is applied as each column result is written: there is
+    // no separate twiddle pass, and every row is final as soon as the last column lands.
+    // (Row k2 takes bin k2 of every column, so no row can start before that.)
+    const complex<float>* w = node.twiddles->data();
+    for (size_t b = 0; b < howmany; b++) {
+        // Stage 1: n1 column FFTs of n2 points, x[n1*j2 + j1] -> s[k2*n1 + j1] * W_n^(k2*j1)
+        run(*node.col, n1, in + b * idist, n1 * istride, istride, s, n1, 1, w);
+        // Stage 2: n2 row FFTs of n1 points, s[k2*n1 + j1] -> X[n2*k1 + k2]
+        run(*node.row, n2, s, 1, n1, out + b * odist, n2 * ostride, ostride,
+            post ? post + b * odist : nullptr);
+    }
+}
+
+// ====== Fast convolution ======
+
+vector<complex<float>> filter_spectrum(FFTPlan& plan, const vector<complex<float>>& taps) {
+    vector<complex<float>> spectrum(plan.size(), complex<float>(0, 0));
+    std::copy(taps.begin(), taps.begin() + std::min(taps.size(), spectrum.size()), spectrum.begin());
+    plan.execute(spectrum.data(), spectrum.data());
+    return spectrum;
+}
+
+void pointwise_multiply(complex<float>* x, const complex<float>* h, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        x[i] = x[i] * h[i];
+    }
+}
+
+// ====== Real-input transforms ======
+
+void pack_real_pair(const float* a, const float* b, complex<float>* z, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        z[i] = complex<float>(a[i], b[i]);
+    }
+}
+
+void split_real_pair(const complex<float>* Z, size_t n, complex<float>* A, complex<float>* B) {
+    for (size_t k = 0; k <= n / 2; k++) {
+        const complex<float>& zk = Z[k % n];
+        const complex<float>& zr = Z[(n - k) % n];   // conj taken below
+        A[k] = complex<float>(0.5f * (zk.real + zr.real), 0.5f * (zk.imag - zr.imag));
+        B[k] = complex<float>(0.5f * (zk.imag + zr.imag), 0.5f * (zr.real - zk.real));
+    }
+}
+
+void pack_real_half(const float* x, complex<float>* z, size_t n) {
+    for (size_t m = 0; m < n / 2; m++) {
+        z[m] = complex<float>(x[2 * m], x[2 * m + 1]);
+    }
+}
+
+void real_half_post_twiddle(const complex<float>* Z, size_t n, complex<float>* X) {
+    const size_t half = n / 2;
+    const auto& w = twiddle_table(n);
+    for (size_t k = 0; k <= half; k++) {
+        const complex<float>& zk = Z[k % half];
+        const complex<float>& zr = Z[(half - k) % half];
+        // E = (Z[k] + conj Z[h-k]) / 2, O = (Z[k] - conj Z[h-k]) / 2i
+        complex<float> e(0.5f * (zk.real + zr.real), 0.5f * (zk.imag - zr.imag));
+        complex<float> o(0.5f * (zk.imag + zr.imag), 0.5f * (zr.real - zk.real));
+        complex<float> wo = w[k % n] * o;
+        X[k] = complex<float>(e.real + wo.real, e.imag + wo.imag);
+    }
+}
+
+} // namespace FFTInitiatorUtils
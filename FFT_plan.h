@@ -0,0 +1,127 @@
+/**
+ * @file FFT_plan.h
+ * @brief FFT plans for FFT_Initiator: plan once, execute many
+ *
+ * A plan captures everything that only depends on the transform size: the
+ * decomposition tree, the twiddle tables of every level, the hardware leaf sizes
+ * (and thus the FFT_TLM configurations) and the intermediate buffers. Executing a
+ * plan only streams data through the hardware leaf executor.
+ */
+
+#ifndef FFT_PLAN_H
+#define FFT_PLAN_H
+
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cstddef>
+
+#include "FFT_initiator_utils.h"
+
+namespace FFTInitiatorUtils {
+
+// Hardware leaf executor: howmany transforms of n (<= base_n) points.
+// Element i of transform b is read from in[b*idist + i*istride],
+// bin k is written in natural order to out[b*odist + k*ostride].
+// If post is not null, bin k is multiplied by post[b*odist + k*ostride] as it is written
+// (post is laid out like out), which fuses a twiddle stage into the output write.
+using FFTLeafExecutor = std::function<void(size_t n, size_t howmany,
+                                           const complex<float>* in, size_t istride, size_t idist,
+                                           complex<float>* out, size_t ostride, size_t odist,
+                                           const complex<float>* post)>;
+
+// One node of the decomposition tree
+struct FFTPlanNode {
+    enum Kind { LEAF, COOLEY_TUKEY, PRIME_FACTOR, BLUESTEIN };
+
+    Kind kind = LEAF;
+    size_t n = 0;
+    // Cooley-Tukey split n = n1 * n2, input index n1*j2 + j1, output index n2*k1 + k2.
+    // Prime-factor (Good-Thomas) split for coprime n1, n2: the CRT index maps below replace the twiddles
+    size_t n1 = 0;
+    size_t n2 = 0;
+    std::unique_ptr<FFTPlanNode> col;       // n2-point sub-plan, run over the n1 columns
+    std::unique_ptr<FFTPlanNode> row;       // n1-point sub-plan, run over the n2 rows
+    const std::vector<complex<float>>* twiddles = nullptr;  // compensation_twiddles(n2, n1)
+    std::vector<complex<float>> scratch;    // n2 x n1 intermediate, reused by every execution
+    std::vector<size_t> input_map;          // PRIME_FACTOR: matrix[j2*n1 + j1] <- x[(j1*n2 + j2*n1) mod n]
+    std::vector<size_t> output_map;         // PRIME_FACTOR: matrix[k2*n1 + k1] -> X[k], k = k1 mod n1 = k2 mod n2
+    // BLUESTEIN: n-point DFT as a length-m (power of two >= 2n-1) circular convolution, col is the m-point plan
+    size_t conv_n = 0;
+    const std::vector<complex<float>>* chirp = nullptr;           // w[j] = exp(-i*pi*j^2/n)
+    const std::vector<complex<float>>* chirp_spectrum = nullptr;  // FFT_m(conj chirp) / m, cached per size
+};
+
+class FFTPlan {
+public:
+    FFTPlan() = default;
+    FFTPlan(size_t n, size_t base_n, FFTLeafExecutor leaf);
+
+    FFTPlan(const FFTPlan&) = delete;
+    FFTPlan& operator=(const FFTPlan&) = delete;
+    FFTPlan(FFTPlan&&) = default;
+    FFTPlan& operator=(FFTPlan&&) = default;
+
+    bool valid() const { return root_ != nullptr; }
+    size_t size() const { return n_; }
+    const FFTPlanNode* root() const { return root_.get(); }
+    // Distinct hardware transform sizes used by the leaves
+    const std::vector<size_t>& leaf_sizes() const { return leaf_sizes_; }
+
+    // One transform, contiguous input and output (in may equal out)
+    void execute(const complex<float>* in, complex<float>* out);
+
+    // Guru batch: howmany independent transforms,
+    // element i of transform b at in[b*idist + i*istride], bin k at out[b*odist + k*ostride].
+    // post (optional, laid out like out) multiplies each bin as it is written
+    void execute_batch(size_t howmany,
+                       const complex<float>* in, size_t istride, size_t idist,
+                       complex<float>* out, size_t ostride, size_t odist,
+                       const complex<float>* post = nullptr);
+
+    // Inverse transforms with 1/n scaling, same layouts as execute/execute_batch.
+    // Runs the forward tree on conjugated data: IFFT(x) = conj(FFT(conj(x))) / n
+    void execute_inverse(const complex<float>* in, complex<float>* out);
+    void execute_batch_inverse(size_t howmany,
+                               const complex<float>* in, size_t istride, size_t idist,
+                               complex<float>* out, size_t ostride, size_t odist);
+
+private:
+    std::unique_ptr<FFTPlanNode> build(size_t n);
+    std::unique_ptr<FFTPlanNode> build_bluestein(std::unique_ptr<FFTPlanNode> node, size_t m);
+    // post: optional per-output multiplier laid out like out (see FFTLeafExecutor)
+    void run(FFTPlanNode& node, size_t howmany,
+             const complex<float>* in, size_t istride, size_t idist,
+             complex<float>* out, size_t ostride, size_t odist,
+             const complex<float>* post = nullptr);
+
+    size_t n_ = 0;
+    size_t base_n_ = 0;
+    FFTLeafExecutor leaf_;
+    std::unique_ptr<FFTPlanNode> root_;
+    std::vector<size_t> leaf_sizes_;
+    std::vector<complex<float>> inverse_scratch_;   // conjugated input of one inverse transform
+};
+
+// ====== Fast convolution ======
+// Spectrum of a filter zero-padded to the plan size, for circular/overlap-save convolution
+std::vector<complex<float>> filter_spectrum(FFTPlan& plan, const std::vector<complex<float>>& taps);
+// x[i] *= h[i], the pointwise stage between the forward and inverse transforms
+void pointwise_multiply(complex<float>* x, const complex<float>* h, size_t n);
+
+// ====== Real-input transforms ======
+// Real frames are packed into complex frames so the complex plans do half the work;
+// outputs are the n/2+1 non-redundant (Hermitian) bins.
+
+// Two real n-point frames as one complex frame z = a + i*b
+void pack_real_pair(const float* a, const float* b, complex<float>* z, size_t n);
+// Z = FFT_n(z): A[k] = (Z[k] + conj Z[n-k]) / 2, B[k] = (Z[k] - conj Z[n-k]) / 2i, k = 0..n/2
+void split_real_pair(const complex<float>* Z, size_t n, complex<float>* A, complex<float>* B);
+// One even n-point real frame as an n/2-point complex frame z[m] = x[2m] + i*x[2m+1]
+void pack_real_half(const float* x, complex<float>* z, size_t n);
+// Z = FFT_(n/2)(z): X[k] = E[k] + W_n^k * O[k], k = 0..n/2
+void real_half_post_twiddle(const complex<float>* Z, size_t n, complex<float>* X);
+
+} // namespace FFTInitiatorUtils
+
+#endif // FFT_PLAN_H
@@ -8,19 +8,38 @@ template <typename T>
 class MatrixBlockTransfer {
 private:
     string transfer_name;
+    //所属initiator的量子保持器，LT模式下块传输延时累加到其中
+    tlm_utils::tlm_quantumkeeper* qk;
+    //批量DMI模式：块内各行在源/目的DMI之间直接拷贝，整块延时累加后只消耗一次
+    bool bulk_dmi;
     
     void read_data(uint64_t addr, vector<T>& values, const tlm::tlm_dmi& dmi, unsigned int data_num) {
-        ins::read_from_dmi(addr, values, dmi, data_num, transfer_name);
+        ins::read_from_dmi(addr, values, dmi, data_num, transfer_name, qk);
     }
     
     void write_data(uint64_t start_addr, uint64_t& end_addr, const vector<T>& values, 
                    const tlm::tlm_dmi& dmi, unsigned int data_num) {
-        ins::write_to_dmi(start_addr, end_addr, values, dmi, data_num, transfer_name);
+        ins::write_to_dmi(start_addr, end_addr, values, dmi, data_num, transfer_name, qk);
+    }
+
+    //批量模式下的块拷贝：rows行，每行cols个元素，返回最后写入的结束地址
+    uint64_t copy_rows_bulk(uint64_t src_addr, uint64_t src_stride, uint64_t dst_addr, uint64_t dst_stride,
+                            int rows, int cols, const tlm::tlm_dmi& source_dmi, const tlm::tlm_dmi& target_dmi) {
+        sc_time delay = SC_ZERO_TIME;
+        uint64_t dst_end_addr = dst_addr;
+        for (int i = 0; i < rows; i++) {
+            ins::dmi_span<T> src = ins::dmi_view<T>(src_addr + i * src_stride, source_dmi, cols, transfer_name);
+            delay += ins::dmi_write_bulk(dst_addr + i * dst_stride, src.data(), target_dmi, src.size(), transfer_name);
+            delay += ins::dmi_transfer_time(src.size() * sizeof(T), source_dmi.get_read_latency());
+            dst_end_addr = dst_addr + i * dst_stride + cols * sizeof(T) - 1;
+        }
+        lt_consume(qk, delay);
+        return dst_end_addr;
     }
 
 public:
-    MatrixBlockTransfer(const string& name) 
-        : transfer_name(name) {}
+    MatrixBlockTransfer(const string& name, tlm_utils::tlm_quantumkeeper* qk = nullptr, bool bulk_dmi = false) 
+        : transfer_name(name), qk(qk), bulk_dmi(bulk_dmi) {}
 
     void transfer(
         uint64_t start_addr, 
@@ -79,11 +98,16 @@ public:
             return;
         }
 
-        vector<T> block_buffer(real_block_cols);
-        for(int i = 0; i < real_block_rows; i++){
-            read_data(start_addr + i * m_cols * sizeof(T), block_buffer, source_dmi, real_block_cols);
-            //check_all_zero(block_buffer);
-            write_data(target_start_addr + i * real_block_cols * sizeof(T), target_end_addr, block_buffer, target_dmi, real_block_cols);
+        if (bulk_dmi) {
+            target_end_addr = copy_rows_bulk(start_addr, m_cols * sizeof(T), target_start_addr, real_block_cols * sizeof(T),
+                                             real_block_rows, real_block_cols, source_dmi, target_dmi);
+        } else {
+            vector<T> block_buffer(real_block_cols);
+            for(int i = 0; i < real_block_rows; i++){
+                read_data(start_addr + i * m_cols * sizeof(T), block_buffer, source_dmi, real_block_cols);
+                //check_all_zero(block_buffer);
+                write_data(target_start_addr + i * real_block_cols * sizeof(T), target_end_addr, block_buffer, target_dmi, real_block_cols);
+            }
         }
         end_addr = start_addr + (((real_block_rows-1) * m_cols+real_block_cols)) * sizeof(T) - 1;
         // 计算下一个块的起始地址
@@ -119,12 +143,17 @@ public:
         const tlm::tlm_dmi& source_dmi, 
         const tlm::tlm_dmi& target_dmi
     ){
-        vector<T> block_buffer(am_cols);
         uint64_t end_addr;
-        for(int i = 0; i<am_rows; i++){
-            read_data(start_addr + i * am_cols * sizeof(T), block_buffer, source_dmi, am_cols);
-            //check_all_zero(block_buffer);
-            write_data(target_start_addr + i * ddr_cols * sizeof(T), end_addr, block_buffer, target_dmi, am_cols);
+        if (bulk_dmi) {
+            end_addr = copy_rows_bulk(start_addr, am_cols * sizeof(T), target_start_addr, ddr_cols * sizeof(T),
+                                      am_rows, am_cols, source_dmi, target_dmi);
+        } else {
+            vector<T> block_buffer(am_cols);
+            for(int i = 0; i<am_rows; i++){
+                read_data(start_addr + i * am_cols * sizeof(T), block_buffer, source_dmi, am_cols);
+                //check_all_zero(block_buffer);
+                write_data(target_start_addr + i * ddr_cols * sizeof(T), end_addr, block_buffer, target_dmi, am_cols);
+            }
         }
         if(end_addr != target_end_addr){
             cout<<"Error transfer_back: "<<transfer_name<<endl;
@@ -158,6 +187,8 @@ public:
     using BaseInitiatorModel<T>::vector_mac;
     //这两个事件是与外界交互的，用于启动和结束GEMM计算
     sc_event start_gemm_event,gemm_done_event;
+    //批量DMI模式(需在仿真开始前设置)：块读写一次拷贝并整段标注延时，不再按64B逐块wait
+    bool bulk_dmi = false;
     //实际矩阵大小，这也是与外界交互的内容，用于初始化矩阵
     int A_rows = 0, A_cols = 0, B_rows = 0, B_cols = 0, C_rows = A_rows, C_cols = B_cols;
     //与子类交互的地址
@@ -215,12 +246,20 @@ public:
 
 
     void read_data(uint64_t addr, vector<T>& values, const tlm::tlm_dmi& dmi, unsigned int data_num) {
-        ins::read_from_dmi(addr, values, dmi, data_num, "Gemm");
+        if (bulk_dmi) {
+            ins::read_from_dmi_bulk(addr, values, dmi, data_num, "Gemm", &this->qk);
+            return;
+        }
+        ins::read_from_dmi(addr, values, dmi, data_num, "Gemm", &this->qk);
     }
     
     void write_data(uint64_t start_addr, uint64_t& end_addr, const vector<T>& values, 
                    const tlm::tlm_dmi& dmi, unsigned int data_num) {
-        ins::write_to_dmi(start_addr, end_addr, values, dmi, data_num, "Gemm");
+        if (bulk_dmi) {
+            ins::write_to_dmi_bulk(start_addr, end_addr, values, dmi, data_num, "Gemm", &this->qk);
+            return;
+        }
+        ins::write_to_dmi(start_addr, end_addr, values, dmi, data_num, "Gemm", &this->qk);
     }
     
     //向量外积C_1D=A_1D*B_1D+C_1D
@@ -288,10 +327,10 @@ public:
             int m,k,n,sm;
             
             // 初始化矩阵传输对象
-            MatrixBlockTransfer<T> gsm_transfer("GSM_Transfer");
-            MatrixBlockTransfer<T> sm_transfer("SM_Transfer");
-            MatrixBlockTransfer<T> amB_transfer("AMB_Transfer");
-            MatrixBlockTransfer<T> amC_transfer("AMC_Transfer");
+            MatrixBlockTransfer<T> gsm_transfer("GSM_Transfer", &this->qk, bulk_dmi);
+            MatrixBlockTransfer<T> sm_transfer("SM_Transfer", &this->qk, bulk_dmi);
+            MatrixBlockTransfer<T> amB_transfer("AMB_Transfer", &this->qk, bulk_dmi);
+            MatrixBlockTransfer<T> amC_transfer("AMC_Transfer", &this->qk, bulk_dmi);
             
             // 预计算循环次数
             int M_blocks = (A_rows + m_gsm_max - 1) / m_gsm_max;  // M方向的块数1
@@ -424,6 +463,7 @@ public:
             
             //MatrixA_DDR_empty = true;
             read_data(Matrix_addr[C][start], MatrixC, ddr_dmi, C_rows * C_cols);
+            lt_sync(&this->qk);
             cout << sc_time_stamp()<< "=====================Gemm计算完成============================" << endl;
             gemm_done_event.notify();
         }
@@ -499,14 +539,15 @@ public:
             uint64_t temp_end_addr;  // 临时变量存储写入结束地址
             write_data(C_addr[AM][start]+C_offset, temp_end_addr, C_block_1D, am_dmi, A_SM_size[row]*B_AM_size[col]);
 
-            // 通知计算完成
+            // 通知计算完成，LT模式下先同步本地时间再跨进程通知
+            lt_sync(&this->qk);
             Gemm_kernel_compute_done_event.notify();
             //cout << "kernel计算完成" << endl;
             
         }
     }
     void Gemm_writeback_C_process() {
-        MatrixBlockTransfer<T> amCback_transfer("AMCback_Transfer");
+        MatrixBlockTransfer<T> amCback_transfer("AMCback_Transfer", &this->qk, bulk_dmi);
         while(true) {
             wait(Gemm_C_write_back_start_event);
             amCback_transfer.transfer_back(
@@ -521,6 +562,7 @@ public:
                 ddr_dmi
             );
 
+            lt_sync(&this->qk);
             Gemm_C_write_back_done_event.notify();
         }
     }
@@ -13,16 +13,18 @@ public:
         cac2ddr_target_socket.register_b_transport(this, &DDR::b_transport);
         cac2ddr_target_socket.register_get_direct_mem_ptr(this, &DDR::get_direct_mem_ptr);
 
-        mem = new T[DDR_SIZE / sizeof(T)];
-        for (uint64_t i = 0; i < DDR_SIZE / sizeof(T); i++) {
-            mem[i] = T();  // 初始化内存
-        }
+        //稀疏后备存储，页面按需分配且天然为零，等价于逐元素初始化为T()
+        mem = reinterpret_cast<T*>(alloc_sparse_memory(DDR_SIZE, "DDR"));
     }
     //阻塞传输方法
     virtual void b_transport(int id, tlm::tlm_generic_payload& trans, sc_time& delay) {
         uint64_t data_length = trans.get_data_length();
         //更新延时信息
         delay += DDR_LATENCY*calculate_clock_cycles(data_length, DDR_DATA_WIDTH);
+        //LT模式下只做延时标注，由initiator按量子统一同步
+        if (lt_mode_enabled()) {
+            return;
+        }
         wait(delay);
     }
     //获取DMI指针
@@ -38,7 +40,7 @@ public:
 
 
     ~DDR() {
-        delete[] mem;
+        free_sparse_memory(reinterpret_cast<unsigned char*>(mem), DDR_SIZE);
     }
 
 private:
@@ -13,16 +13,18 @@ public:
     GSM(sc_module_name name) : sc_module(name), cac2gsm_target_socket("cac2gsm_target_socket") {
         cac2gsm_target_socket.register_get_direct_mem_ptr(this, &GSM::get_direct_mem_ptr);
         cac2gsm_target_socket.register_b_transport(this, &GSM::b_transport);
-        mem = new T[GSM_SIZE / sizeof(T)];
-        for (uint64_t i = 0; i < GSM_SIZE / sizeof(T); i++) {
-            mem[i] = T();  // Initialize memory
-        }
+        //稀疏后备存储，页面按需分配且天然为零，等价于逐元素初始化为T()
+        mem = reinterpret_cast<T*>(alloc_sparse_memory(GSM_SIZE, "GSM"));
     }
         //阻塞传输方法
     virtual void b_transport(int id, tlm::tlm_generic_payload& trans, sc_time& delay) {
         uint64_t data_length = trans.get_data_length();
         //更新延时信息
         delay += DDR_LATENCY*calculate_clock_cycles(data_length, DDR_DATA_WIDTH);
+        //LT模式下只做延时标注，由initiator按量子统一同步
+        if (lt_mode_enabled()) {
+            return;
+        }
         wait(delay);
     }
     virtual bool get_direct_mem_ptr(int id, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
@@ -36,7 +38,7 @@ public:
     }
 
     ~GSM() {
-        delete[] mem;
+        free_sparse_memory(reinterpret_cast<unsigned char*>(mem), GSM_SIZE);
     }
 
 private:
@@ -23,11 +23,13 @@ SC_MODULE(Soc) {
     SC_CTOR(Soc) {
         ext2soc_target_socket.register_get_direct_mem_ptr(this, &Soc::ext2soc_get_direct_mem_ptr);
         ext2soc_target_socket.register_b_transport(this, &Soc::ext2soc_b_transport);
+        ext2soc_target_socket.register_nb_transport_fw(this, &Soc::ext2soc_nb_transport_fw);
         vcore2soc_target_socket.register_b_transport(this, &Soc::vcore2soc_b_transport);
         vcore2soc_target_socket.register_get_direct_mem_ptr(this, &Soc::vcore2soc_get_direct_mem_ptr);
 
         soc2ext_initiator_socket.register_invalidate_direct_mem_ptr(this,&Soc::invalidate_direct_mem_ptr);
         soc2vcore_initiator_socket.register_invalidate_direct_mem_ptr(this,&Soc::invalidate_direct_mem_ptr);
+        soc2vcore_initiator_socket.register_nb_transport_bw(this, &Soc::soc2vcore_nb_transport_bw);
         
         cac = new CAC<T>("CAC");
         ddr = new DDR<T>("DDR");
@@ -47,6 +49,20 @@ SC_MODULE(Soc) {
     void ext2soc_b_transport(int ID, tlm::tlm_generic_payload& trans, sc_time& delay) {
         soc2vcore_initiator_socket->b_transport(trans, delay);
     }
+    //非阻塞传输：前向透传给VCore，反向按记录的socket编号返回给外部initiator
+    tlm::tlm_sync_enum ext2soc_nb_transport_fw(int ID, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        if (phase == tlm::BEGIN_REQ) {
+            nb_route.record(&trans, ID);
+        }
+        tlm::tlm_sync_enum status = soc2vcore_initiator_socket->nb_transport_fw(trans, phase, delay);
+        nb_route.release(&trans, phase, status);
+        return status;
+    }
+    tlm::tlm_sync_enum soc2vcore_nb_transport_bw(int ID, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        tlm::tlm_sync_enum status = ext2soc_target_socket[nb_route.lookup(&trans)]->nb_transport_bw(trans, phase, delay);
+        nb_route.release(&trans, phase, status);
+        return status;
+    }
     bool vcore2soc_get_direct_mem_ptr(int ID, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
         return soc2ext_initiator_socket->get_direct_mem_ptr(trans, dmi_data);
     }
@@ -56,6 +72,8 @@ SC_MODULE(Soc) {
     virtual void invalidate_direct_mem_ptr(int ID, sc_dt::uint64 start_range, sc_dt::uint64 end_range) {
         cout << "DMI invalidated. Range: " << hex << start_range << " - " << end_range << endl;
     }
+    //非阻塞事务的反向路由表
+    nb_route_table nb_route;
     //析构函数
     ~Soc() {
         delete cac;
@@ -51,6 +51,8 @@ public:
         // 注册所有回调函数
         soc2vcore_target_socket.register_b_transport(this, &VCore::soc2vcore_b_transport);
         soc2vcore_target_socket.register_get_direct_mem_ptr(this, &VCore::soc2vcore_get_direct_mem_ptr);
+        soc2vcore_target_socket.register_nb_transport_fw(this, &VCore::soc2vcore_nb_transport_fw);
+        vcore2spu_init_socket.register_nb_transport_bw(this, &VCore::vcore2spu_nb_transport_bw);
         
         spu2vcore_target_socket.register_b_transport(this, &VCore::spu2vcore_b_transport);
         spu2vcore_target_socket.register_get_direct_mem_ptr(this, &VCore::spu2vcore_get_direct_mem_ptr);
@@ -87,6 +89,20 @@ public:
     void soc2vcore_b_transport(int ID, tlm::tlm_generic_payload& trans, sc_time& delay) {
         this->vcore2spu_init_socket->b_transport(trans, delay);
     }
+    //非阻塞传输：前向透传给SPU，反向按记录的socket编号返回给Soc
+    tlm::tlm_sync_enum soc2vcore_nb_transport_fw(int ID, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        if (phase == tlm::BEGIN_REQ) {
+            nb_route.record(&trans, ID);
+        }
+        tlm::tlm_sync_enum status = this->vcore2spu_init_socket->nb_transport_fw(trans, phase, delay);
+        nb_route.release(&trans, phase, status);
+        return status;
+    }
+    tlm::tlm_sync_enum vcore2spu_nb_transport_bw(int ID, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        tlm::tlm_sync_enum status = soc2vcore_target_socket[nb_route.lookup(&trans)]->nb_transport_bw(trans, phase, delay);
+        nb_route.release(&trans, phase, status);
+        return status;
+    }
     void spu2vcore_b_transport(int ID, tlm::tlm_generic_payload& trans, sc_time& delay) {
         this->vcore2cac_init_socket->b_transport(trans, delay);
     }
@@ -111,6 +127,9 @@ public:
         return vcore2soc_init_socket->get_direct_mem_ptr(trans, dmi_data);
     }
 
+    //非阻塞事务的反向路由表
+    nb_route_table nb_route;
+
     ~VCore() {
         delete vpu;
         delete sm;
@@ -39,7 +39,12 @@ public:
         }
         
         trans.set_response_status(tlm::TLM_OK_RESPONSE);
-        wait(AM_LATENCY);
+        //LT模式下只做延时标注，由initiator按量子统一同步
+        if (lt_mode_enabled()) {
+            delay += AM_LATENCY;
+        } else {
+            wait(AM_LATENCY);
+        }
     }
 
 private:
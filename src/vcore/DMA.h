@@ -3,56 +3,118 @@
 
 #include "../../util/const.h"
 #include "../../util/tools.h"
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
-//简单连续传输参数结构体
-struct Simple_Continuous_Trans_Param{
-    uint8_t trans_mode;           //传输模式,0:简单连续传输，
-    uint64_t Source_addr;         //源开始地址
-    uint64_t Destination_addr;    //目的开始地址
-    uint32_t Transfer_length;     //传输长度,单位字节，最大为1GB(0x4000 0000)，最小为1字节
-};
-//点对点传输参数结构体
-struct Point2Point_Trans_Param{
-    uint8_t trans_mode;           //传输模式,3:点对点传输
-    uint64_t Source_addr;         //源开始地址
-    uint64_t Source_array_index;          //源帧索引
-    uint32_t Source_elem_Byte_num;      //源单元计数
-    uint32_t Source_array_num;          //源帧计数
-    uint64_t Destination_addr;          //目的开始地址
-    uint64_t Destination_array_index;          //目的帧索引
-    uint32_t Destination_elem_Byte_num;      //目的单元计数
-    uint32_t Destination_array_num;          //目的帧计数
+//============ 矩阵转置内核 ============
+//rows x cols 的行主序矩阵src转置写入dst(cols x rows)，元素大小elem字节。
+//按DMA_TRANSPOSE_CACHE_BLOCK分块保证源/目标都在缓存内，块内用SIMD微块寄存器转置：
+//4B元素4x4、8B元素2x2、16B元素单元素128位搬运，其余元素大小逐元素拷贝
+inline void dma_transpose_scalar(const unsigned char* src, unsigned char* dst, uint32_t rows, uint32_t cols, uint32_t elem,
+                                 uint32_t i0, uint32_t i1, uint32_t j0, uint32_t j1) {
+    for (uint32_t i = i0; i < i1; i++) {
+        for (uint32_t j = j0; j < j1; j++) {
+            memcpy(dst + (static_cast<uint64_t>(j) * rows + i) * elem, src + (static_cast<uint64_t>(i) * cols + j) * elem, elem);
+        }
+    }
+}
 
-};
-//矩阵转置传输参数结构体
-struct Matrix_Transpose_Trans_Param{
-    uint8_t trans_mode;           //传输模式,1:矩阵转置传输，
-    uint64_t Source_addr;         //源开始地址
-    uint64_t Destination_addr;    //目的开始地址
-    uint32_t Row_num;             //行数
-    uint32_t Column_num;          //列数
-    uint32_t element_byte_num;    //元素字节数
-    bool is_complex;                //是否为复数，默认不为复数
-};
-//SG传输参数结构体
-struct SG_Trans_Param{
-    uint8_t trans_mode;           //传输模式,2:SG传输
-    uint64_t Destination_addr;    //目的开始地址
-    uint64_t Destination_array_index;          //目的帧索引
-    uint32_t Destination_elem_Byte_num;      //目的单元计数
-    uint32_t Destination_array_num;          //目的帧计数
-};
+inline void dma_transpose_bytes(const unsigned char* src, unsigned char* dst, uint32_t rows, uint32_t cols, uint32_t elem) {
+    const uint32_t cb = DMA_TRANSPOSE_CACHE_BLOCK;
+#if defined(__SSE2__)
+    const uint32_t micro = (elem == 4) ? 4 : (elem == 8) ? 2 : (elem == 16) ? 1 : 0;
+#else
+    const uint32_t micro = 0;
+#endif
+    const uint64_t src_stride = static_cast<uint64_t>(cols) * elem;
+    const uint64_t dst_stride = static_cast<uint64_t>(rows) * elem;
+    for (uint32_t ib = 0; ib < rows; ib += cb) {
+        uint32_t ie = std::min(ib + cb, rows);
+        for (uint32_t jb = 0; jb < cols; jb += cb) {
+            uint32_t je = std::min(jb + cb, cols);
+            if (micro == 0) {
+                dma_transpose_scalar(src, dst, rows, cols, elem, ib, ie, jb, je);
+                continue;
+            }
+#if defined(__SSE2__)
+            // 整微块部分
+            uint32_t ifull = ib + (ie - ib) / micro * micro;
+            uint32_t jfull = jb + (je - jb) / micro * micro;
+            for (uint32_t i = ib; i < ifull; i += micro) {
+                for (uint32_t j = jb; j < jfull; j += micro) {
+                    const unsigned char* s = src + i * src_stride + static_cast<uint64_t>(j) * elem;
+                    unsigned char* d = dst + j * dst_stride + static_cast<uint64_t>(i) * elem;
+                    if (elem == 4) {
+                        __m128 r0 = _mm_loadu_ps(reinterpret_cast<const float*>(s));
+                        __m128 r1 = _mm_loadu_ps(reinterpret_cast<const float*>(s + src_stride));
+                        __m128 r2 = _mm_loadu_ps(reinterpret_cast<const float*>(s + 2 * src_stride));
+                        __m128 r3 = _mm_loadu_ps(reinterpret_cast<const float*>(s + 3 * src_stride));
+                        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                        _mm_storeu_ps(reinterpret_cast<float*>(d), r0);
+                        _mm_storeu_ps(reinterpret_cast<float*>(d + dst_stride), r1);
+                        _mm_storeu_ps(reinterpret_cast<float*>(d + 2 * dst_stride), r2);
+                        _mm_storeu_ps(reinterpret_cast<float*>(d + 3 * dst_stride), r3);
+                    } else if (elem == 8) {
+                        __m128d r0 = _mm_loadu_pd(reinterpret_cast<const double*>(s));
+                        __m128d r1 = _mm_loadu_pd(reinterpret_cast<const double*>(s + src_stride));
+                        _mm_storeu_pd(reinterpret_cast<double*>(d), _mm_unpacklo_pd(r0, r1));
+                        _mm_storeu_pd(reinterpret_cast<double*>(d + dst_stride), _mm_unpackhi_pd(r0, r1));
+                    } else {
+                        _mm_storeu_si128(reinterpret_cast<__m128i*>(d), 
+                                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+                    }
+                }
+            }
+            // 块边缘不足一个微块的部分
+            dma_transpose_scalar(src, dst, rows, cols, elem, ib, ifull, jfull, je);
+            dma_transpose_scalar(src, dst, rows, cols, elem, ifull, ie, jb, je);
+#endif
+        }
+    }
+}
 
-union Trans_Param{
-    Simple_Continuous_Trans_Param sctp;
-    Matrix_Transpose_Trans_Param mttp;
-    SG_Trans_Param sgtp;
-    Point2Point_Trans_Param p2pt;
+//DMA描述符：一条DMA命令解码后的参数及其所属payload，在通道FIFO中排队
+struct DMA_Descriptor{
+    uint8_t trans_mode;
+    Trans_Param param;
+    tlm::tlm_generic_payload* payload;
+    uint32_t channel_id = 0;        //所属通道
+    int nb_socket_id = -1;          //非阻塞请求的来源socket编号，-1表示阻塞(b_transport)请求
 };
 
 template<typename T>
 class DMA : public sc_module
 {
+private:
+    //dma状态变量
+    enum DMA_STATE{
+        IDLE,
+        BUSY,
+        SG_READY,
+        ERROR
+    };
+
+    //DMA通道：独立的描述符FIFO、工作进程、DMI对象和完成状态
+    struct DMA_Channel{
+        uint32_t id = 0;
+        DMA_STATE state = IDLE;
+        std::deque<DMA_Descriptor> desc_fifo;
+        sc_event desc_push_event;   //描述符入队
+        sc_event desc_pop_event;    //描述符出队，FIFO有空位
+        sc_event done_event;        //描述符执行完成
+        uint64_t completed_num = 0; //已完成描述符数
+        uint64_t error_num = 0;     //出错描述符数
+        sc_time dma_delay = sc_time(0, SC_NS);
+        //LT模式下通道本地时间的量子保持器
+        tlm_utils::tlm_quantumkeeper qk;
+        // 声明DMI对象
+        tlm::tlm_dmi dmi_read;
+        tlm::tlm_dmi dmi_write;
+        tlm::tlm_generic_payload read_trans;
+        tlm::tlm_generic_payload write_trans;
+    };
+
 public:
     tlm_utils::multi_passthrough_target_socket<DMA, 512> spu2dma_target_socket;
     tlm_utils::multi_passthrough_initiator_socket<DMA, 512> dma2sm_init_socket;
@@ -65,15 +127,20 @@ public:
     {
         spu2dma_target_socket.register_b_transport(this, &DMA::b_transport);
         spu2dma_target_socket.register_get_direct_mem_ptr(this, &DMA::get_direct_mem_ptr);
+        spu2dma_target_socket.register_nb_transport_fw(this, &DMA::nb_transport_fw);
 
         dma2sm_init_socket.register_invalidate_direct_mem_ptr(this, &DMA::invalidate_direct_mem_ptr);
         dma2am_init_socket.register_invalidate_direct_mem_ptr(this, &DMA::invalidate_direct_mem_ptr);
         dma2vcore_init_socket.register_invalidate_direct_mem_ptr(this, &DMA::invalidate_direct_mem_ptr);
-        SC_THREAD(init_process);
-        SC_THREAD(simple_continuous_trans_process);
-        SC_THREAD(matrix_transpose_transfer);
-        SC_THREAD(sg_transfer_process);
-        SC_THREAD(point2point_transfer);
+        //每个通道一个独立的工作进程，按FIFO顺序处理本通道的描述符，通道之间并行
+        for (uint32_t i = 0; i < DMA_CHANNEL_NUM; i++) {
+            channels[i].id = i;
+            channels[i].qk.reset();
+            sc_spawn(sc_bind(&DMA::channel_process, this, i),
+                     ("dma_channel_" + to_string(i)).c_str());
+        }
+        //非阻塞请求接纳进程：在途请求数或通道FIFO有空位时接纳等待中的请求并回复END_REQ
+        SC_THREAD(nb_admit_process);
         //三种传输模式实现
         // //1、点对点传输
         // SC_THREAD(point_to_point_transfer);
@@ -83,690 +150,648 @@ public:
         // SC_THREAD(matrix_transpose_transfer);
     }
 
-    //初始化过程
-    void init_process(){
+    //通道工作进程：从描述符FIFO取出命令，按传输模式分发，完成后回写通道状态并通知initiator
+    void channel_process(uint32_t channel_id){
+        DMA_Channel& ch = channels[channel_id];
         while(true){
-            wait(init_process_start_event);
-            switch(trans_mode_flag){
+            while(ch.desc_fifo.empty()){
+                wait(ch.desc_push_event);
+            }
+            DMA_Descriptor desc = ch.desc_fifo.front();
+            ch.desc_fifo.pop_front();
+            ch.desc_pop_event.notify(SC_ZERO_TIME);
+            if(!nb_pending.empty()){
+                nb_admit_event.notify(SC_ZERO_TIME);
+            }
+            ch.state = BUSY;
+            ch.qk.reset();
+
+            bool ok = false;
+            switch(desc.trans_mode){
                 case 0x00:
-                    simple_continuous_trans_event.notify();
+                    ok = simple_continuous_trans(ch, desc.param.sctp);
                     break;
                 case 0x01:
-                    matrix_transpose_transfer_event.notify();
+                    ok = matrix_transpose_transfer(ch, desc.param.mttp);
                     break;
                 case 0x02:
-                    sg_transfer_event.notify();
+                    ok = sg_transfer(ch, desc.param.sgtp);
                     break;
                 case 0x03:
-                    point2point_transfer_event.notify();
+                    ok = point2point_transfer(ch, desc.param.p2pt);
                     break;
                 default:
                     SC_REPORT_ERROR("DMA", "Unsupported transfer mode");
-                    sc_stop();
                     break;
             }
-        }
-    }   
-    //简单连续传输过程
-    void simple_continuous_trans_process(){
-        while(true) {
-            wait(simple_continuous_trans_event);
-            Simple_Continuous_Trans_Param sctp_param = dma_param.sctp;
-            
-            vector<unsigned char> buffer;
-
-            //启动读数据流程，从source_addr开始，读取Transfer_length个字节,使用dmi的方法
-            dma_read_trans.set_address(sctp_param.Source_addr);
-            dma_read_trans.set_read();
-            
-            // 获取源地址的DMI访问权限
-            if (!get_dmi_access(dma_read_trans, dmi_data_read, sctp_param.Source_addr, "source")) {
-                dma_state = ERROR;
-                return;
+            //完成通知前把本地累加的时间同步到仿真内核
+            lt_sync(&ch.qk);
+            ch.dma_delay = sc_time(0, SC_NS);
+            if(ok){
+                ch.completed_num++;
+                ch.state = ch.desc_fifo.empty() ? IDLE : BUSY;
+                notify_trans_done(*desc.payload);
+            }else{
+                //出错的描述符以错误响应结束，通道继续处理后续描述符
+                ch.error_num++;
+                ch.state = ERROR;
+                notify_trans_done(*desc.payload, tlm::TLM_GENERIC_ERROR_RESPONSE);
             }
-
-            // 检查DMI读取权限
-            if (!dmi_data_read.is_read_allowed()) {
-                SC_REPORT_ERROR("DMA", "DMI read not allowed");
-                dma_state = ERROR;
-                return;
+            ch.done_event.notify();
+            //非阻塞请求通过反向路径发送BEGIN_RESP
+            if(desc.nb_socket_id >= 0){
+                send_nb_response(desc);
             }
-
-            // 读取数据到缓冲区
-            buffer.resize(sctp_param.Transfer_length);
-            unsigned char* src_ptr = dmi_data_read.get_dmi_ptr() + 
-                                   (sctp_param.Source_addr - dmi_data_read.get_start_address());
-            memcpy(buffer.data(), src_ptr, sctp_param.Transfer_length);
-            dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(sctp_param.Transfer_length, SM_AM_DATA_WIDTH);
-            wait(dma_delay);
-            //启动写数据流程，向destination_addr开始，写入Transfer_length个字节，使用dmi的方法
-            dma_write_trans.set_address(sctp_param.Destination_addr);
-            dma_write_trans.set_write();
-
-            // 获取目标地址的DMI访问权限
-            if (!get_dmi_access(dma_write_trans, dmi_data_write, sctp_param.Destination_addr, "destination")) {
-                dma_state = ERROR;
-                return;
+            //归还入队时持有的payload引用，池化payload在此回到内存池
+            if(desc.payload->has_mm()){
+                desc.payload->release();
             }
-            // 检查DMI写入权限
-            if (!dmi_data_write.is_write_allowed()) {
-                SC_REPORT_ERROR("DMA", "DMI write not allowed");
-                dma_state = ERROR;
-                return;
+        }
+    }
+    //非阻塞请求完成：发送BEGIN_RESP，initiator直接返回TLM_COMPLETED时即释放在途名额
+    void send_nb_response(const DMA_Descriptor& desc){
+        tlm::tlm_phase phase = tlm::BEGIN_RESP;
+        sc_time delay = SC_ZERO_TIME;
+        tlm::tlm_sync_enum status = spu2dma_target_socket[desc.nb_socket_id]->nb_transport_bw(*desc.payload, phase, delay);
+        if(status == tlm::TLM_COMPLETED || phase == tlm::END_RESP){
+            release_nb_slot();
+        }
+    }
+    void release_nb_slot(){
+        if(nb_outstanding > 0){
+            nb_outstanding--;
+        }
+        nb_admit_event.notify(SC_ZERO_TIME);
+    }
+    //接纳等待中的非阻塞请求，按到达顺序，队首请求的通道FIFO已满时等待
+    void nb_admit_process(){
+        while(true){
+            wait(nb_admit_event);
+            while(!nb_pending.empty() && nb_outstanding < DMA_MAX_OUTSTANDING){
+                DMA_Descriptor desc = nb_pending.front();
+                DMA_Channel& ch = channels[desc.channel_id];
+                if(ch.desc_fifo.size() >= DMA_DESC_FIFO_DEPTH){
+                    break;
+                }
+                nb_pending.pop_front();
+                enqueue_descriptor(desc);
+                tlm::tlm_phase phase = tlm::END_REQ;
+                sc_time delay = SC_ZERO_TIME;
+                spu2dma_target_socket[desc.nb_socket_id]->nb_transport_bw(*desc.payload, phase, delay);
             }
+        }
+    }
+    //简单连续传输过程
+    bool simple_continuous_trans(DMA_Channel& ch, const Simple_Continuous_Trans_Param& sctp_param){
+        vector<unsigned char> buffer;
+
+        //启动读数据流程，从source_addr开始，读取Transfer_length个字节,使用dmi的方法
+        ch.read_trans.set_address(sctp_param.Source_addr);
+        ch.read_trans.set_read();
+        
+        // 获取源地址的DMI访问权限
+        if (!get_dmi_access(ch.read_trans, ch.dmi_read, sctp_param.Source_addr, "source")) {
+            return false;
+        }
+
+        // 检查DMI读取权限
+        if (!ch.dmi_read.is_read_allowed()) {
+            SC_REPORT_ERROR("DMA", "DMI read not allowed");
+            return false;
+        }
 
-            // 写入数据
-            unsigned char* dst_ptr = dmi_data_write.get_dmi_ptr() + 
-                                   (sctp_param.Destination_addr - dmi_data_write.get_start_address());
-            memcpy(dst_ptr, buffer.data(), sctp_param.Transfer_length);
-            dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(sctp_param.Transfer_length, SM_AM_DATA_WIDTH);
-            wait(dma_delay);
+        // 读取数据到缓冲区
+        buffer.resize(sctp_param.Transfer_length);
+        unsigned char* src_ptr = ch.dmi_read.get_dmi_ptr() + 
+                               (sctp_param.Source_addr - ch.dmi_read.get_start_address());
+        memcpy(buffer.data(), src_ptr, sctp_param.Transfer_length);
+        ch.dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(sctp_param.Transfer_length, SM_AM_DATA_WIDTH);
+        lt_consume(&ch.qk, ch.dma_delay);
+        //启动写数据流程，向destination_addr开始，写入Transfer_length个字节，使用dmi的方法
+        ch.write_trans.set_address(sctp_param.Destination_addr);
+        ch.write_trans.set_write();
 
-            //通知传输事务完成，dma_state设置为IDLE
-            dma_payload->set_response_status(tlm::TLM_OK_RESPONSE);
-            dma_state = IDLE;
-            simple_continuous_trans_done_event.notify();
-            dma_delay = sc_time(0, SC_NS);
+        // 获取目标地址的DMI访问权限
+        if (!get_dmi_access(ch.write_trans, ch.dmi_write, sctp_param.Destination_addr, "destination")) {
+            return false;
         }
+        // 检查DMI写入权限
+        if (!ch.dmi_write.is_write_allowed()) {
+            SC_REPORT_ERROR("DMA", "DMI write not allowed");
+            return false;
+        }
+
+        // 写入数据
+        unsigned char* dst_ptr = ch.dmi_write.get_dmi_ptr() + 
+                               (sctp_param.Destination_addr - ch.dmi_write.get_start_address());
+        memcpy(dst_ptr, buffer.data(), sctp_param.Transfer_length);
+        ch.dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(sctp_param.Transfer_length, SM_AM_DATA_WIDTH);
+        lt_consume(&ch.qk, ch.dma_delay);
+        return true;
     }
     //新建点对点传输模式
-    void point2point_transfer(){
-        while(true) {
-            wait(point2point_transfer_event);
-            Point2Point_Trans_Param p2pt_param = dma_param.p2pt;
-            
-            // 获取源和目标的参数
-            uint64_t source_addr = p2pt_param.Source_addr;
-            uint64_t source_array_index = p2pt_param.Source_array_index;
-            uint32_t source_elem_byte_num = p2pt_param.Source_elem_Byte_num;
-            uint32_t source_array_num = p2pt_param.Source_array_num;
-            
-            uint64_t destination_addr = p2pt_param.Destination_addr;
-            uint64_t destination_array_index = p2pt_param.Destination_array_index;
-            uint32_t destination_elem_byte_num = p2pt_param.Destination_elem_Byte_num;
-            uint32_t destination_array_num = p2pt_param.Destination_array_num;
-            
-            // 获取源地址的DMI访问权限
-            dma_read_trans.set_address(source_addr);
-            dma_read_trans.set_read();
-            if (!get_dmi_access(dma_read_trans, dmi_data_read, source_addr, "source")) {
-                dma_state = ERROR;
-                return;
-            }
-            
-            // 获取目标地址的DMI访问权限
-            dma_write_trans.set_address(destination_addr);
-            dma_write_trans.set_write();
-            if (!get_dmi_access(dma_write_trans, dmi_data_write, destination_addr, "destination")) {
-                dma_state = ERROR;
-                return;
+    //源帧序列按字节流依次填入目标帧序列，双指针直接从源DMI拷贝到目标DMI，不经过中间缓冲区。
+    //帧间距等于帧长(或只有一帧)的一侧视为一段连续区域，因此两侧都连续时退化为一次拷贝，
+    //帧长相同的等间距传输每帧一次拷贝
+    bool point2point_transfer(DMA_Channel& ch, const Point2Point_Trans_Param& p2pt_param){
+        // 获取源和目标的参数
+        uint64_t source_addr = p2pt_param.Source_addr;
+        uint64_t source_array_index = p2pt_param.Source_array_index;
+        uint32_t source_elem_byte_num = p2pt_param.Source_elem_Byte_num;
+        uint32_t source_array_num = p2pt_param.Source_array_num;
+        
+        uint64_t destination_addr = p2pt_param.Destination_addr;
+        uint64_t destination_array_index = p2pt_param.Destination_array_index;
+        uint32_t destination_elem_byte_num = p2pt_param.Destination_elem_Byte_num;
+        uint32_t destination_array_num = p2pt_param.Destination_array_num;
+        
+        // 获取源地址的DMI访问权限
+        ch.read_trans.set_address(source_addr);
+        ch.read_trans.set_read();
+        if (!get_dmi_access(ch.read_trans, ch.dmi_read, source_addr, "source")) {
+            return false;
+        }
+        
+        // 获取目标地址的DMI访问权限
+        ch.write_trans.set_address(destination_addr);
+        ch.write_trans.set_write();
+        if (!get_dmi_access(ch.write_trans, ch.dmi_write, destination_addr, "destination")) {
+            return false;
+        }
+        
+        // 计算总传输数据量
+        uint64_t total_source_bytes = static_cast<uint64_t>(source_elem_byte_num) * source_array_num;
+        uint64_t total_bytes = std::min(
+            total_source_bytes,
+            static_cast<uint64_t>(destination_elem_byte_num) * destination_array_num
+        );
+        
+        // 连续的一侧合并为一段：段长为总字节数，否则段长为帧长、段间距为帧索引
+        bool source_contiguous = (source_array_index == source_elem_byte_num) || (source_array_num <= 1);
+        bool destination_contiguous = (destination_array_index == destination_elem_byte_num) || (destination_array_num <= 1);
+        uint64_t src_run_bytes = source_contiguous ? total_bytes : source_elem_byte_num;
+        uint64_t dst_run_bytes = destination_contiguous ? total_bytes : destination_elem_byte_num;
+        
+        // 检查源、目标访问范围均在DMI窗口内
+        if (total_bytes > 0) {
+            uint64_t src_last = source_contiguous ? source_addr + total_bytes - 1 :
+                source_addr + ((total_bytes - 1) / source_elem_byte_num) * source_array_index + 
+                (total_bytes - 1) % source_elem_byte_num;
+            uint64_t dst_last = destination_contiguous ? destination_addr + total_bytes - 1 :
+                destination_addr + ((total_bytes - 1) / destination_elem_byte_num) * destination_array_index + 
+                (total_bytes - 1) % destination_elem_byte_num;
+            if (src_last > ch.dmi_read.get_end_address() || dst_last > ch.dmi_write.get_end_address()) {
+                SC_REPORT_ERROR("DMA", "P2P transfer out of DMI range");
+                return false;
             }
-            
-            // 计算单周期最大传输字节数
-            const uint32_t max_bytes_per_cycle = 64;//512bits
-            
-            // 创建中间缓冲区，用于存储从源读取的所有数据
-            vector<unsigned char> buffer;
-            uint64_t total_source_bytes = source_elem_byte_num * source_array_num;
-            buffer.resize(total_source_bytes);
-            
-            // 从源地址按帧读取数据
-            unsigned char* src_dmi_ptr = dmi_data_read.get_dmi_ptr();
-            unsigned char* dst_dmi_ptr = dmi_data_write.get_dmi_ptr();
-            
-            // 处理每一帧源数据
-            for (uint32_t src_frame = 0; src_frame < source_array_num; ++src_frame) {
-                // 计算当前源帧起始地址
-                uint64_t src_frame_addr = source_addr + src_frame * source_array_index;
-                uint64_t src_frame_offset = src_frame_addr - dmi_data_read.get_start_address();
-                
-                // 计算缓冲区中当前帧的起始位置
-                uint64_t buffer_offset = src_frame * source_elem_byte_num;
-                
-                // 当前帧还剩需要传输的字节数
-                uint32_t remaining_bytes = source_elem_byte_num;
-                // 当前帧中已处理的字节数
-                uint32_t processed_bytes = 0;
-                
-                // 分批读取当前帧数据，每批最多读取max_bytes_per_cycle字节
-                while (remaining_bytes > 0) {
-                    // 当前批次要读取的字节数
-                    uint32_t batch_bytes = std::min(remaining_bytes, max_bytes_per_cycle);
-                    
-                    // 计算源数据指针
-                    unsigned char* src_ptr = src_dmi_ptr + src_frame_offset + processed_bytes;
-                    
-                    // 复制数据到buffer
-                    memcpy(buffer.data() + buffer_offset + processed_bytes, src_ptr, batch_bytes);
-                    
-                    // 更新已处理和剩余字节数
-                    processed_bytes += batch_bytes;
-                    remaining_bytes -= batch_bytes;
-                    
-                    // 每批次读取后等待一个时钟周期
-                    //wait(SYSTEM_CLOCK);
+        }
+        
+        unsigned char* src_base = ch.dmi_read.get_dmi_ptr() + (source_addr - ch.dmi_read.get_start_address());
+        unsigned char* dst_base = ch.dmi_write.get_dmi_ptr() + (destination_addr - ch.dmi_write.get_start_address());
+        
+        if (source_contiguous && destination_contiguous) {
+            // 两侧都连续：一次拷贝完成(源和目标可能重叠，使用memmove)
+            memmove(dst_base, src_base, total_bytes);
+        } else {
+            // 双指针：每次拷贝源段剩余与目标段剩余中的较小者
+            uint64_t src_run = 0, src_run_offset = 0;
+            uint64_t dst_run = 0, dst_run_offset = 0;
+            uint64_t copied_bytes = 0;
+            while (copied_bytes < total_bytes) {
+                uint64_t batch_bytes = std::min({src_run_bytes - src_run_offset, 
+                                                 dst_run_bytes - dst_run_offset,
+                                                 total_bytes - copied_bytes});
+                memcpy(dst_base + dst_run * destination_array_index + dst_run_offset,
+                       src_base + src_run * source_array_index + src_run_offset, batch_bytes);
+                copied_bytes += batch_bytes;
+                src_run_offset += batch_bytes;
+                dst_run_offset += batch_bytes;
+                if (src_run_offset == src_run_bytes) {
+                    src_run++;
+                    src_run_offset = 0;
                 }
-            }
-            
-            // 将数据从buffer写入到目标地址，按目标帧结构组织
-            for (uint32_t dst_frame = 0; dst_frame < destination_array_num; ++dst_frame) {
-                // 计算目标帧地址
-                uint64_t dst_frame_addr = destination_addr + dst_frame * destination_array_index;
-                uint64_t dst_frame_offset = dst_frame_addr - dmi_data_write.get_start_address();
-                
-                // 确定要写入的数据量(不超过源数据总量且不超过目标帧大小)
-                uint32_t bytes_to_write = std::min(
-                    destination_elem_byte_num,  // 目标帧大小
-                    static_cast<uint32_t>(total_source_bytes - dst_frame * destination_elem_byte_num)  // 剩余源数据量
-                );
-                
-                if (bytes_to_write <= 0) break; // 没有更多数据可写
-                
-                // 当前帧还剩需要传输的字节数
-                uint32_t remaining_bytes = bytes_to_write;
-                // 当前帧中已处理的字节数
-                uint32_t processed_bytes = 0;
-                // 缓冲区偏移量
-                uint64_t buffer_read_offset = dst_frame * destination_elem_byte_num;
-                
-                if (buffer_read_offset >= total_source_bytes) break; // 防止缓冲区越界
-                
-                // 分批写入当前帧数据，每批最多写入max_bytes_per_cycle字节
-                while (remaining_bytes > 0) {
-                    // 当前批次要写入的字节数
-                    uint32_t batch_bytes = std::min(remaining_bytes, max_bytes_per_cycle);
-                    
-                    // 计算目标数据指针
-                    unsigned char* dst_ptr = dst_dmi_ptr + dst_frame_offset + processed_bytes;
-                    
-                    // 复制数据到目标位置
-                    memcpy(dst_ptr, buffer.data() + buffer_read_offset + processed_bytes, batch_bytes);
-                    
-                    // 更新已处理和剩余字节数
-                    processed_bytes += batch_bytes;
-                    remaining_bytes -= batch_bytes;
-                    
-                    // 每批次写入后等待一个时钟周期
-                    //wait(SYSTEM_CLOCK);
+                if (dst_run_offset == dst_run_bytes) {
+                    dst_run++;
+                    dst_run_offset = 0;
                 }
             }
-            
-            // 计算总传输数据量
-            uint64_t total_bytes = std::min(
-                static_cast<uint64_t>(source_elem_byte_num) * source_array_num,
-                static_cast<uint64_t>(destination_elem_byte_num) * destination_array_num
-            );
-            dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(total_bytes, SM_AM_DATA_WIDTH);
-            wait(dma_delay);
-            
-            // 通知传输事务完成
-            dma_payload->set_response_status(tlm::TLM_OK_RESPONSE);
-            dma_state = IDLE;
-            point2point_transfer_done_event.notify();
-            dma_delay = sc_time(0, SC_NS);
-            
-            // cout << "点对点传输完成: 源(" << source_array_num << "帧, 每帧" << dec << source_elem_byte_num 
-            //      << "字节) -> 目标(" << destination_array_num << "帧, 每帧" << destination_elem_byte_num << endl;
         }
+        
+        ch.dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(total_bytes, SM_AM_DATA_WIDTH);
+        lt_consume(&ch.qk, ch.dma_delay);
+        
+        // cout << "点对点传输完成: 源(" << source_array_num << "帧, 每帧" << dec << source_elem_byte_num 
+        //      << "字节) -> 目标(" << destination_array_num << "帧, 每帧" << destination_elem_byte_num << endl;
+        return true;
     }
     //矩阵转置传输过程,完成了分块矩阵转置传输
-    void matrix_transpose_transfer(){
-        while(true){
-            wait(matrix_transpose_transfer_event);
-            Matrix_Transpose_Trans_Param mttp_param = dma_param.mttp;
-            bool is_complex = mttp_param.is_complex;
-
-            // 获取源地址的DMI访问权限
-            dma_read_trans.set_address(mttp_param.Source_addr);
-            dma_read_trans.set_read();
-            if (!get_dmi_access(dma_read_trans, dmi_data_read, mttp_param.Source_addr, "source")) {
-                dma_state = ERROR;
-                return;
-            }
-            // 获取目标地址的DMI访问权限
-            dma_write_trans.set_address(mttp_param.Destination_addr);
-            dma_write_trans.set_write();      
-            if (!get_dmi_access(dma_write_trans, dmi_data_write, mttp_param.Destination_addr, "destination")) {
-                dma_state = ERROR;
-                return;
-            }
-            //计算基础块矩阵的行数和列数（元素数）,基础矩阵块是方阵
-            uint32_t basic_row_num = 64/mttp_param.element_byte_num;
-            uint32_t basic_col_num = basic_row_num;
-            // cout << "basic_row_num: " << basic_row_num << endl;
-            // cout << "basic_col_num: " << basic_col_num << endl;
-            //此处是分块逻辑
-            //首先计算行能分成多少块(块行个数)
-            uint32_t row_num_block = (mttp_param.Row_num + basic_row_num - 1)/basic_row_num;
-            //其次计算列能分成多少块(块列个数)
-            uint32_t col_num_block = (mttp_param.Column_num + basic_col_num - 1)/basic_col_num;
-            // cout << "row_num_block: " << row_num_block << endl;
-            // cout << "col_num_block: " << col_num_block << endl;
-            //先行后列，逐个遍历矩阵块
-            for(int r = 0; r < row_num_block; r++){
-                for(int c = 0; c < col_num_block; c++){
-                    //计算本块的起始地址和目标块起始地址
-                    uint64_t current_block_start_addr = mttp_param.Source_addr + r * mttp_param.Column_num * basic_row_num * mttp_param.element_byte_num + c * basic_col_num * mttp_param.element_byte_num;
-                    uint64_t current_block_target_addr = mttp_param.Destination_addr + c * mttp_param.Row_num * basic_col_num * mttp_param.element_byte_num + r * basic_row_num * mttp_param.element_byte_num;
-                    //计算此块真实的行数和列数  
-                    uint32_t current_block_row_num = (mttp_param.Row_num - r * basic_row_num) > basic_row_num ? basic_row_num : (mttp_param.Row_num - r * basic_row_num);
-                    uint32_t current_block_col_num = (mttp_param.Column_num - c * basic_col_num) > basic_col_num ? basic_col_num : (mttp_param.Column_num - c * basic_col_num);
-                    // cout << "current_block_row_num: " << current_block_row_num << endl;
-                    // cout << "current_block_col_num: " << current_block_col_num << endl;
-                    if (is_complex) {
-                        // 复数类型处理
-                        vector<complex<T>> buffer_mt_before(current_block_row_num * current_block_col_num);
-                        vector<complex<T>> buffer_mt_after(current_block_row_num * current_block_col_num);
-                        complex<T>* src_ptr;
-                        complex<T>* dst_ptr;
-                        
-                        // 初始化二维寄存器阵列
-                        vector<vector<complex<T>>> basic_martix_array(current_block_row_num, vector<complex<T>>(current_block_col_num));
-                        
-                        // 读取数据
-                        for (int i = 0; i < current_block_row_num; i++) {
-                            src_ptr = reinterpret_cast<complex<T>*>(dmi_data_read.get_dmi_ptr() + 
-                                (current_block_start_addr - dmi_data_read.get_start_address()) + i * mttp_param.Column_num * mttp_param.element_byte_num);
-                            memcpy(buffer_mt_before.data() + i * current_block_col_num, src_ptr, current_block_col_num * mttp_param.element_byte_num);
-                        }
-                        
-                        // 写入寄存器阵列
-                        for(int i = 0; i < current_block_row_num; i++){
-                            for(int j = 0; j < current_block_col_num; j++){
-                                basic_martix_array[i][j] = buffer_mt_before[i*current_block_col_num+j];
-                            }
-                            wait(SYSTEM_CLOCK);
-                        }
-                        
-                        // 转置读出
-                        for (int i = 0; i < current_block_col_num; i++) {
-                            for (int j = 0; j < current_block_row_num; j++) {
-                                buffer_mt_after[i * current_block_row_num + j] = basic_martix_array[j][i];
-                            }
-                        }
-                        
-                        // 写回目标
-                        for(int i = 0; i < current_block_col_num; i++){
-                            dst_ptr = reinterpret_cast<complex<T>*>(dmi_data_write.get_dmi_ptr() + 
-                                (current_block_target_addr-dmi_data_write.get_start_address())+i*mttp_param.Row_num*mttp_param.element_byte_num);
-                            memcpy(dst_ptr, buffer_mt_after.data()+i*current_block_row_num, current_block_row_num*mttp_param.element_byte_num);
-                        }
-                    } else {
-                        // 原始普通类型处理
-                        vector<T> buffer_mt_before(current_block_row_num * current_block_col_num);
-                        vector<T> buffer_mt_after(current_block_row_num * current_block_col_num);
-                        T* src_ptr;
-                        T* dst_ptr;
-                        
-                        // 初始化二维寄存器阵列
-                        vector<vector<T>> basic_martix_array(current_block_row_num, vector<T>(current_block_col_num, 0));
-                        
-                        // 读取数据
-                        for (int i = 0; i < current_block_row_num; i++) {
-                            src_ptr = reinterpret_cast<T*>(dmi_data_read.get_dmi_ptr() + 
-                                (current_block_start_addr - dmi_data_read.get_start_address()) + i * mttp_param.Column_num * mttp_param.element_byte_num);
-                            memcpy(buffer_mt_before.data() + i * current_block_col_num, src_ptr, current_block_col_num * mttp_param.element_byte_num);
-                        }
-                        
-                        // 写入寄存器阵列
-                        for(int i = 0; i < current_block_row_num; i++){
-                            for(int j = 0; j < current_block_col_num; j++){
-                                basic_martix_array[i][j] = buffer_mt_before[i*current_block_col_num+j];
-                            }
-                            wait(SYSTEM_CLOCK);
-                        }
-                        
-                        // 转置读出
-                        for (int i = 0; i < current_block_col_num; i++) {
-                            for (int j = 0; j < current_block_row_num; j++) {
-                                buffer_mt_after[i * current_block_row_num + j] = basic_martix_array[j][i];
-                            }
-                        }
-                        
-                        // 写回目标
-                        for(int i = 0; i < current_block_col_num; i++){
-                            dst_ptr = reinterpret_cast<T*>(dmi_data_write.get_dmi_ptr() + 
-                                (current_block_target_addr-dmi_data_write.get_start_address())+i*mttp_param.Row_num*mttp_param.element_byte_num);
-                            memcpy(dst_ptr, buffer_mt_after.data()+i*current_block_row_num, current_block_row_num*mttp_param.element_byte_num);
-                        }
-                    }
-                }
-            }
-            //通知传输事务完成，dma_state设置为IDLE
-            dma_payload->set_response_status(tlm::TLM_OK_RESPONSE);
-            dma_state = IDLE;
-            matrix_transpose_transfer_done_event.notify();
-            dma_delay = sc_time(0, SC_NS);
+    //数据搬运用缓存分块+SIMD寄存器内转置一次完成；时序仍按64B基础块建模：
+    //每个基础块每行一个时钟周期，总周期数为 块列数*行数，整次传输只同步一次
+    bool matrix_transpose_transfer(DMA_Channel& ch, const Matrix_Transpose_Trans_Param& mttp_param){
+        // 复数(is_complex)按element_byte_num字节整体作为一个元素转置，与实数共用同一内核
+        uint32_t element_byte_num = mttp_param.element_byte_num;
+        if (element_byte_num == 0 || element_byte_num > SM_AM_DATA_WIDTH) {
+            SC_REPORT_ERROR("DMA", "Unsupported element size for matrix transpose");
+            return false;
+        }
+
+        // 获取源地址的DMI访问权限
+        ch.read_trans.set_address(mttp_param.Source_addr);
+        ch.read_trans.set_read();
+        if (!get_dmi_access(ch.read_trans, ch.dmi_read, mttp_param.Source_addr, "source")) {
+            return false;
         }
+        // 获取目标地址的DMI访问权限
+        ch.write_trans.set_address(mttp_param.Destination_addr);
+        ch.write_trans.set_write();      
+        if (!get_dmi_access(ch.write_trans, ch.dmi_write, mttp_param.Destination_addr, "destination")) {
+            return false;
+        }
+        uint64_t matrix_bytes = static_cast<uint64_t>(mttp_param.Row_num) * mttp_param.Column_num * element_byte_num;
+        if (matrix_bytes == 0) {
+            return true;
+        }
+        if (mttp_param.Source_addr + matrix_bytes - 1 > ch.dmi_read.get_end_address() ||
+            mttp_param.Destination_addr + matrix_bytes - 1 > ch.dmi_write.get_end_address()) {
+            SC_REPORT_ERROR("DMA", "Matrix transpose out of DMI range");
+            return false;
+        }
+        //计算基础块矩阵的行数和列数（元素数）,基础矩阵块是方阵
+        uint32_t basic_col_num = SM_AM_DATA_WIDTH / element_byte_num;
+        //块列个数
+        uint32_t col_num_block = (mttp_param.Column_num + basic_col_num - 1) / basic_col_num;
+
+        const unsigned char* src_ptr = ch.dmi_read.get_dmi_ptr() + 
+                                       (mttp_param.Source_addr - ch.dmi_read.get_start_address());
+        unsigned char* dst_ptr = ch.dmi_write.get_dmi_ptr() + 
+                                 (mttp_param.Destination_addr - ch.dmi_write.get_start_address());
+        dma_transpose_bytes(src_ptr, dst_ptr, mttp_param.Row_num, mttp_param.Column_num, element_byte_num);
+
+        //每个基础块逐行写入寄存器阵列，每行一个周期
+        ch.dma_delay = SYSTEM_CLOCK * (static_cast<uint64_t>(col_num_block) * mttp_param.Row_num);
+        lt_consume(&ch.qk, ch.dma_delay);
+        return true;
     }
     
     //SG传输过程，完成分散读取集合写入
-    void sg_transfer_process() {
-        while(true) {
-            wait(sg_transfer_event);
-            SG_Trans_Param sgtp_param = dma_param.sgtp;
-            
-            // 从SM共享内存中读取SG传输配置参数
-            uint64_t sg_config_addr = 0x010020f00; // SG配置参数在SM中的地址
-            
-            // 获取SM的DMI访问权限
-            dma_read_trans.set_address(sg_config_addr);
-            dma_read_trans.set_read();
-            if (!get_dmi_access(dma_read_trans, dmi_data_read, sg_config_addr, "SM config")) {
-                dma_state = ERROR;
-                return;
+    //配置块格式(uint64_t数组)：[0]控制字(低16位为分散块数，SG_PARAM_VALID_BIT有效，SG_PARAM_CHAIN_BIT链接)，
+    //[1]源基地址，[2..data_num+1]为(字节偏移<<32 | 长度)，链接时[data_num+2]为下一配置块在SM中的地址。
+    //各分散块按顺序直接写入目标帧结构，不经过中间缓冲区，整条链共用一个目标写指针
+    bool sg_transfer(DMA_Channel& ch, const SG_Trans_Param& sgtp_param) {
+        // 每个通道的首个配置块位于SM中各自的配置区
+        uint64_t sg_config_addr = SG_CONFIG_ADDR + ch.id * SG_CONFIG_SIZE;
+
+        // 获取目标地址的DMI访问权限
+        uint64_t destination_addr = sgtp_param.Destination_addr;
+        uint64_t destination_array_index = sgtp_param.Destination_array_index;
+        uint32_t destination_elem_byte_num = sgtp_param.Destination_elem_Byte_num;
+        uint32_t destination_array_num = sgtp_param.Destination_array_num;
+        ch.write_trans.set_address(destination_addr);
+        ch.write_trans.set_write();
+        if (!get_dmi_access(ch.write_trans, ch.dmi_write, destination_addr, "destination")) {
+            return false;
+        }
+        uint64_t last_frame_end = destination_addr + 
+            static_cast<uint64_t>(destination_array_num - 1) * destination_array_index + destination_elem_byte_num - 1;
+        if (destination_array_num == 0 || last_frame_end > ch.dmi_write.get_end_address()) {
+            SC_REPORT_ERROR("DMA", "SG destination frames out of DMI range");
+            return false;
+        }
+        unsigned char* dst_dmi_ptr = ch.dmi_write.get_dmi_ptr();
+
+        // 目标写指针：当前帧号及帧内偏移
+        uint32_t dst_frame = 0;
+        uint32_t dst_frame_offset = 0;
+        uint64_t total_bytes = 0;
+        uint32_t block_num = 0;
+        tlm::tlm_dmi config_dmi;
+        tlm::tlm_generic_payload config_trans;
+
+        while (true) {
+            // 获取SM的DMI访问权限，读取本配置块
+            config_trans.set_address(sg_config_addr);
+            config_trans.set_read();
+            if (!get_dmi_access(config_trans, config_dmi, sg_config_addr, "SM config")) {
+                return false;
             }
-            
-            // 读取SG参数
-            unsigned char* sm_ptr = dmi_data_read.get_dmi_ptr() + 
-                                 (sg_config_addr - dmi_data_read.get_start_address());
-            uint64_t* sg_config = reinterpret_cast<uint64_t*>(sm_ptr);
-            
+            const uint64_t* sg_config = reinterpret_cast<const uint64_t*>(config_dmi.get_dmi_ptr() + 
+                                        (sg_config_addr - config_dmi.get_start_address()));
+
             // 检查SG参数是否有效
             uint64_t sg_param = sg_config[0];
-            bool sg_valid = (sg_param & 0x10000) != 0; // 第17位为有效位
-            if (!sg_valid) {
+            if ((sg_param & SG_PARAM_VALID_BIT) == 0) {
                 SC_REPORT_ERROR("DMA", "SG parameters not valid");
-                dma_state = ERROR;
-                return;
+                return false;
             }
-            
-            // 获取数据块数量
-            // cout << "DMA: sg_param: "  << sg_param << endl;
-            uint32_t data_num = sg_param & 0xFFFF; // 低16位为数据块数量
-            // cout << "DMA: data_num: " << data_num << endl;
-            
-            // 获取源地址
+            uint32_t data_num = sg_param & SG_DATA_NUM_MASK;
+            bool chained = (sg_param & SG_PARAM_CHAIN_BIT) != 0;
             uint64_t source_base_addr = sg_config[1];
-            // cout << "DMA: source_base_addr: "<< hex << source_base_addr << dec << endl;
-            // 目标地址
-            uint64_t destination_addr = sgtp_param.Destination_addr;
-            
-            // 获取分散数据块的索引和长度
-            vector<uint32_t> byte_index_list(data_num);
-            vector<uint32_t> length_list(data_num);
-            
-            for (unsigned int i = 0; i < data_num; i++) {
-                uint64_t sg_entry = sg_config[i+2];
-                byte_index_list[i] = static_cast<uint32_t>(sg_entry >> 32);
-                length_list[i] = static_cast<uint32_t>(sg_entry & 0xFFFFFFFF);
+
+            // 分散读取，直接写入目标帧
+            for (uint32_t i = 0; i < data_num && dst_frame < destination_array_num; i++) {
+                uint64_t sg_entry = sg_config[i + 2];
+                uint64_t src_addr = source_base_addr + static_cast<uint32_t>(sg_entry >> 32);
+                uint32_t length = static_cast<uint32_t>(sg_entry & 0xFFFFFFFF);
+                if (length == 0) {
+                    continue;   // 空块，避免下面 src_addr + length - 1 下溢
+                }
+
+                // 源地址不在当前DMI窗口内时重新获取，新窗口仍须覆盖整个分散块
+                if (!ch.dmi_read.is_read_allowed() || src_addr < ch.dmi_read.get_start_address() ||
+                    src_addr + length - 1 > ch.dmi_read.get_end_address()) {
+                    ch.read_trans.set_address(src_addr);
+                    ch.read_trans.set_read();
+                    if (!get_dmi_access(ch.read_trans, ch.dmi_read, src_addr, "source")) {
+                        return false;
+                    }
+                    if (src_addr < ch.dmi_read.get_start_address() ||
+                        src_addr + length - 1 > ch.dmi_read.get_end_address()) {
+                        SC_REPORT_ERROR("DMA", "SG source block out of DMI range");
+                        return false;
+                    }
+                }
+                const unsigned char* src_ptr = ch.dmi_read.get_dmi_ptr() + 
+                                               (src_addr - ch.dmi_read.get_start_address());
+
+                // 一个分散块可能跨越多个目标帧
+                while (length > 0 && dst_frame < destination_array_num) {
+                    uint32_t batch_bytes = std::min(length, destination_elem_byte_num - dst_frame_offset);
+                    uint64_t dst_addr = destination_addr + dst_frame * destination_array_index + dst_frame_offset;
+                    memcpy(dst_dmi_ptr + (dst_addr - ch.dmi_write.get_start_address()), src_ptr, batch_bytes);
+                    src_ptr += batch_bytes;
+                    length -= batch_bytes;
+                    total_bytes += batch_bytes;
+                    dst_frame_offset += batch_bytes;
+                    if (dst_frame_offset == destination_elem_byte_num) {
+                        dst_frame++;
+                        dst_frame_offset = 0;
+                    }
+                }
             }
-            
-            // 获取目标地址的DMI访问权限
-            dma_write_trans.set_address(destination_addr);
-            dma_write_trans.set_write();
-            if (!get_dmi_access(dma_write_trans, dmi_data_write, destination_addr, "destination")) {
-                dma_state = ERROR;
-                return;
+            block_num++;
+
+            // 目标帧已写满或链结束
+            if (!chained || dst_frame >= destination_array_num) {
+                break;
             }
-            
-            // 分散读取
-            vector<unsigned char> buffer;
-            uint64_t total_bytes = 0;
-            
-            // 计算总数据量
-            for (unsigned int i = 0; i < data_num; i++) {
-                total_bytes += length_list[i];
+            sg_config_addr = sg_config[data_num + 2];
+            if (block_num >= SG_MAX_CHAIN_LEN) {
+                SC_REPORT_ERROR("DMA", "SG descriptor chain too long (loop?)");
+                return false;
             }
-            
-            // 调整缓冲区大小
-            buffer.resize(total_bytes);
-            uint64_t buffer_offset = 0;
-            
-            // 分散读取数据
-            for (unsigned int i = 0; i < data_num; i++) {
-                uint64_t src_addr = source_base_addr + byte_index_list[i];
-                uint32_t length = length_list[i];
+        }
+
+        // 按实际搬运的总字节数计算传输延迟
+        ch.dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(total_bytes, SM_AM_DATA_WIDTH);
+        lt_consume(&ch.qk, ch.dma_delay);
+
+        // cout << "DMA : SG传输完成: " << block_num << "个配置块，总计" << total_bytes 
+        //      << "字节数据，写入到地址0x" << hex << destination_addr << dec << endl;
+        return true;
+    }
+    //阻塞传输方法，逻辑控制器
+    //写命令：解码为描述符压入对应通道的FIFO，FIFO满时阻塞等待，入队后立即返回，
+    //传输完成由通道进程通过payload的响应状态(及完成扩展)通知；
+    //读命令：返回通道状态字
+    virtual void b_transport(int id, tlm::tlm_generic_payload& trans, sc_time& delay )
+    {
+        int channel_id = channel_of(trans.get_address());
+        if(channel_id < 0){
+            notify_trans_done(trans, tlm::TLM_ADDRESS_ERROR_RESPONSE);
+            return;
+        }
+        DMA_Channel& ch = channels[channel_id];
+
+        if(trans.is_read()){
+            //通道状态字：[7:0]通道状态，[15:8]FIFO中等待的描述符数，[63:32]已完成描述符数
+            uint64_t status = static_cast<uint64_t>(ch.state)
+                            | (static_cast<uint64_t>(ch.desc_fifo.size() & 0xFF) << 8)
+                            | (static_cast<uint64_t>(ch.completed_num) << 32);
+            memcpy(trans.get_data_ptr(), &status, std::min<uint64_t>(trans.get_data_length(), sizeof(status)));
+            trans.set_response_status(tlm::TLM_OK_RESPONSE);
+            return;
+        }
+
+        DMA_Descriptor desc;
+        desc.payload = &trans;
+        desc.channel_id = channel_id;
+        if(!load_descriptor(trans, desc)){
+            notify_trans_done(trans, tlm::TLM_COMMAND_ERROR_RESPONSE);
+            return;
+        }
+        //描述符FIFO已满，反压initiator直到通道取走一个描述符
+        while(ch.desc_fifo.size() >= DMA_DESC_FIFO_DEPTH){
+            wait(ch.desc_pop_event);
+        }
+        enqueue_descriptor(desc);
+    }
+    //非阻塞传输方法(AT)：
+    //BEGIN_REQ：解码后若在途请求数未达DMA_MAX_OUTSTANDING且通道FIFO有空位，立即接纳并返回END_REQ，
+    //否则挂起，待有空位时由nb_admit_process通过反向路径回复END_REQ；
+    //传输完成后通道进程发送BEGIN_RESP；END_RESP释放在途名额
+    tlm::tlm_sync_enum nb_transport_fw(int id, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay)
+    {
+        if(phase == tlm::END_RESP){
+            release_nb_slot();
+            return tlm::TLM_COMPLETED;
+        }
+        if(phase != tlm::BEGIN_REQ){
+            SC_REPORT_ERROR("DMA", "nb_transport_fw: unexpected phase");
+            return tlm::TLM_COMPLETED;
+        }
+        int channel_id = channel_of(trans.get_address());
+        DMA_Descriptor desc;
+        desc.payload = &trans;
+        desc.nb_socket_id = id;
+        if(channel_id < 0 || trans.is_read() || !load_descriptor(trans, desc)){
+            trans.set_response_status(channel_id < 0 ? tlm::TLM_ADDRESS_ERROR_RESPONSE : tlm::TLM_COMMAND_ERROR_RESPONSE);
+            phase = tlm::END_RESP;
+            return tlm::TLM_COMPLETED;
+        }
+        desc.channel_id = channel_id;
+        if(nb_pending.empty() && nb_outstanding < DMA_MAX_OUTSTANDING &&
+           channels[channel_id].desc_fifo.size() < DMA_DESC_FIFO_DEPTH){
+            enqueue_descriptor(desc);
+            phase = tlm::END_REQ;
+            return tlm::TLM_UPDATED;
+        }
+        nb_pending.push_back(desc);
+        return tlm::TLM_ACCEPTED;
+    }
+    //由地址计算通道号，越界返回-1
+    int channel_of(uint64_t address){
+        if(address < DMA_BASE_ADDR || (address - DMA_BASE_ADDR) / DMA_CHANNEL_REG_SIZE >= DMA_CHANNEL_NUM){
+            SC_REPORT_ERROR("DMA", "DMA channel address out of range");
+            return -1;
+        }
+        return static_cast<int>((address - DMA_BASE_ADDR) / DMA_CHANNEL_REG_SIZE);
+    }
+    //描述符入队并唤醒通道进程，非阻塞请求计入在途名额；
+    //带内存管理器的payload在传输完成前持有一个引用
+    void enqueue_descriptor(const DMA_Descriptor& desc){
+        DMA_Channel& ch = channels[desc.channel_id];
+        if(desc.nb_socket_id >= 0){
+            nb_outstanding++;
+        }
+        if(desc.payload->has_mm()){
+            desc.payload->acquire();
+        }
+        ch.desc_fifo.push_back(desc);
+        ch.state = BUSY;
+        ch.desc_push_event.notify();
+    }
+    //取出payload携带的DMA命令：带dma_descriptor_extension时直接拷贝其中的类型化参数，
+    //否则按寄存器命令字节流解码(兼容接口)
+    bool load_descriptor(tlm::tlm_generic_payload& trans, DMA_Descriptor& desc){
+        dma_descriptor_extension* desc_ext = nullptr;
+        trans.get_extension(desc_ext);
+        if(desc_ext == nullptr){
+            return decode_descriptor(trans.get_data_ptr(), desc);
+        }
+        if(desc_ext->trans_mode > 0x03){
+            SC_REPORT_ERROR("DMA", "Unsupported transfer mode");
+            return false;
+        }
+        desc.trans_mode = desc_ext->trans_mode;
+        desc.param = desc_ext->param;
+        return true;
+    }
+    //将命令字节流解码为DMA描述符
+    bool decode_descriptor(const unsigned char* data, DMA_Descriptor& desc){
+        // 传输模式，获取第1个字节
+        desc.trans_mode = data[0];
+        switch(desc.trans_mode){
+            case 0x00:
+                desc.param.sctp.trans_mode = desc.trans_mode;
+                // 源地址，获取第2-9个字节（8字节地址）
+                desc.param.sctp.Source_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.sctp.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
+                }
+                // 目的地址，获取第10-17个字节（8字节地址）
+                desc.param.sctp.Destination_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.sctp.Destination_addr |= ((uint64_t)data[9 + i] << (i * 8));
+                }
+                // 传输长度，获取第18-21个字节（4字节长度）
+                desc.param.sctp.Transfer_length = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.sctp.Transfer_length |= ((uint32_t)data[17 + i] << (i * 8));
+                }
                 
-                // 获取源地址的DMI访问权限
-                dma_read_trans.set_address(src_addr);
-                dma_read_trans.set_read();
-                if (!get_dmi_access(dma_read_trans, dmi_data_read, src_addr, "source")) {
-                    dma_state = ERROR;
-                    return;
+                break;
+            case 0x01:
+                desc.param.mttp.trans_mode = desc.trans_mode;
+                // 源地址，获取第2-9个字节（8字节地址）
+                desc.param.mttp.Source_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.mttp.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
+                }
+                // 目的地址，获取第10-17个字节（8字节地址）
+                desc.param.mttp.Destination_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.mttp.Destination_addr |= ((uint64_t)data[9 + i] << (i * 8));
+                }
+                // 行数，获取第18-21个字节（4字节行数）
+                desc.param.mttp.Row_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.mttp.Row_num |= ((uint32_t)data[17 + i] << (i * 8));
+                }
+                // 列数，获取第22-25个字节（4字节列数）
+                desc.param.mttp.Column_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.mttp.Column_num |= ((uint32_t)data[21 + i] << (i * 8));
+                }
+                // 元素字节数，获取第26-29个字节（4字节元素字节数）
+                desc.param.mttp.element_byte_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.mttp.element_byte_num |= ((uint32_t)data[25 + i] << (i * 8));
+                }
+                // 是否为复数，获取第30个字节（1字节，0表示实数，1表示复数）
+                desc.param.mttp.is_complex = data[29];
+                break;
+            case 0x02:
+                desc.param.sgtp.trans_mode = desc.trans_mode;
+                // 目的地址，获取第2-9个字节（8字节地址）
+                desc.param.sgtp.Destination_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.sgtp.Destination_addr |= ((uint64_t)data[1 + i] << (i * 8));
+                }
+                // 目标帧索引，获取第10-17个字节（8字节索引）
+                desc.param.sgtp.Destination_array_index = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.sgtp.Destination_array_index |= ((uint64_t)data[9 + i] << (i * 8));
                 }
                 
-                // 读取数据到缓冲区
-                unsigned char* src_ptr = dmi_data_read.get_dmi_ptr() + 
-                                      (src_addr - dmi_data_read.get_start_address());
-                memcpy(buffer.data() + buffer_offset, src_ptr, length);
-                buffer_offset += length;
+                // 目标单元字节数，获取第18-21个字节（4字节计数）
+                desc.param.sgtp.Destination_elem_Byte_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.sgtp.Destination_elem_Byte_num |= ((uint32_t)data[17 + i] << (i * 8));
+                }
                 
-                // 模拟读取延迟
-                dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(length, SM_AM_DATA_WIDTH);
-                //wait(dma_delay);
-            }
-            
-            // 按照与点对点传输相同的模式数据帧模式写入数据
-            unsigned char* dst_dmi_ptr = dmi_data_write.get_dmi_ptr();
-            
-            // 获取目标参数
-            // uint64_t destination_addr = sgtp_param.Destination_addr;
-            uint64_t destination_array_index = sgtp_param.Destination_array_index;
-            uint32_t destination_elem_byte_num = sgtp_param.Destination_elem_Byte_num;
-            uint32_t destination_array_num = sgtp_param.Destination_array_num;
-            
-            // 计算单周期最大传输字节数
-            const uint32_t max_bytes_per_cycle = 64; // 512bits
-            // cout << "DMA:sg_tranfer:准备将数据写入目标地址" << endl;
-            // cout << "DMA:sg_tranfer:destination_array_num: " << destination_array_num << endl;
-            // cout << "DMA:sg_tranfer:destination_array_index: " << destination_array_index << endl;
-            // cout << "DMA:sg_tranfer:destination_elem_byte_num: " << destination_elem_byte_num << endl;
-            // cout << "DMA:sg_tranfer:total_bytes: " << total_bytes << endl;
-            // 将数据从buffer写入到目标地址，按目标帧结构组织
-            for (uint32_t dst_frame = 0; dst_frame < destination_array_num; ++dst_frame) {
-                // 计算目标帧地址
-                uint64_t dst_frame_addr = destination_addr + dst_frame * destination_array_index;
-                uint64_t dst_frame_offset = dst_frame_addr - dmi_data_write.get_start_address();
+                // 目标帧数，获取第22-25个字节（4字节计数）
+                desc.param.sgtp.Destination_array_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.sgtp.Destination_array_num |= ((uint32_t)data[21 + i] << (i * 8));
+                }
                 
-                // 确定要写入的数据量(不超过源数据总量且不超过目标帧大小)
-                uint32_t bytes_to_write = std::min(
-                    destination_elem_byte_num, // 目标帧大小
-                    static_cast<uint32_t>(total_bytes - dst_frame * destination_elem_byte_num) // 剩余源数据量
-                );
+                break;
+            case 0x03:
+                desc.param.p2pt.trans_mode = desc.trans_mode;
                 
-                if (bytes_to_write <= 0) break; // 没有更多数据可写
+                // 源地址，获取第2-9个字节（8字节地址）
+                desc.param.p2pt.Source_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.p2pt.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
+                }
                 
-                // 当前帧还剩需要传输的字节数
-                uint32_t remaining_bytes = bytes_to_write;
-                // 当前帧中已处理的字节数
-                uint32_t processed_bytes = 0;
-                // 缓冲区偏移量
-                uint64_t buffer_read_offset = dst_frame * destination_elem_byte_num;
+                // 源帧索引，获取第10-17个字节（8字节索引）
+                desc.param.p2pt.Source_array_index = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.p2pt.Source_array_index |= ((uint64_t)data[9 + i] << (i * 8));
+                }
                 
-                if (buffer_read_offset >= total_bytes) break; // 防止缓冲区越界
+                // 源单元字节数，获取第18-21个字节（4字节计数）
+                desc.param.p2pt.Source_elem_Byte_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.p2pt.Source_elem_Byte_num |= ((uint32_t)data[17 + i] << (i * 8));
+                }
                 
-                // 分批写入当前帧数据，每批最多写入max_bytes_per_cycle字节
-                while (remaining_bytes > 0) {
-                    // 当前批次要写入的字节数
-                    uint32_t batch_bytes = std::min(remaining_bytes, max_bytes_per_cycle);
-                    
-                    // 计算目标数据指针
-                    unsigned char* dst_ptr = dst_dmi_ptr + dst_frame_offset + processed_bytes;
-                    
-                    // 复制数据到目标位置
-                    memcpy(dst_ptr, buffer.data() + buffer_read_offset + processed_bytes, batch_bytes);
-                    
-                    // 更新已处理和剩余字节数
-                    processed_bytes += batch_bytes;
-                    remaining_bytes -= batch_bytes;
-                    
-                    // 每批次写入后等待一个时钟周期
-                    //wait(SYSTEM_CLOCK);
+                // 源帧数，获取第22-25个字节（4字节计数）
+                desc.param.p2pt.Source_array_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.p2pt.Source_array_num |= ((uint32_t)data[21 + i] << (i * 8));
                 }
-            }
-            
-            //cout << "DMA:sg_tranfer:数据写入目标地址完成" << endl;
-            // 模拟写入延迟
-            dma_delay = SYSTEM_CLOCK * calculate_clock_cycles(total_bytes, SM_AM_DATA_WIDTH);
-            wait(dma_delay);
-            
-            // 通知传输事务完成
-            dma_payload->set_response_status(tlm::TLM_OK_RESPONSE);
-            dma_state = IDLE;
-            sg_transfer_done_event.notify();
-            dma_delay = sc_time(0, SC_NS);
-            
-            // cout << "DMA : SG传输完成: 从" << data_num << "个分散块读取总计" << total_bytes 
-            //      << "字节数据，写入到地址0x" << hex << destination_addr << dec << endl;
+                
+                // 目标地址，获取第26-33个字节（8字节地址）
+                desc.param.p2pt.Destination_addr = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.p2pt.Destination_addr |= ((uint64_t)data[25 + i] << (i * 8));
+                }
+                
+                // 目标帧索引，获取第34-41个字节（8字节索引）
+                desc.param.p2pt.Destination_array_index = 0;
+                for(int i = 0; i < 8; i++) {
+                    desc.param.p2pt.Destination_array_index |= ((uint64_t)data[33 + i] << (i * 8));
+                }
+                
+                // 目标单元字节数，获取第42-45个字节（4字节计数）
+                desc.param.p2pt.Destination_elem_Byte_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.p2pt.Destination_elem_Byte_num |= ((uint32_t)data[41 + i] << (i * 8));
+                }
+                
+                // 目标帧数，获取第46-49个字节（4字节计数）
+                desc.param.p2pt.Destination_array_num = 0;
+                for(int i = 0; i < 4; i++) {
+                    desc.param.p2pt.Destination_array_num |= ((uint32_t)data[45 + i] << (i * 8));
+                }
+                break;
+            default:
+                SC_REPORT_ERROR("DMA", "Unsupported transfer mode");
+                return false;
         }
-    }
-    //阻塞传输方法，逻辑控制器
-    virtual void b_transport(int id, tlm::tlm_generic_payload& trans, sc_time& delay )
-    {
-        unsigned char* data = trans.get_data_ptr();
-        dma_payload = &trans;
-        if(dma_state == IDLE){
-            // 传输模式，获取第1个字节
-            trans_mode_flag = data[0];
-            switch(trans_mode_flag){
-                case 0x00:
-                    dma_param.sctp.trans_mode = trans_mode_flag;
-                    // 源地址，获取第2-9个字节（8字节地址）
-                    dma_param.sctp.Source_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.sctp.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
-                    }
-                    // 目的地址，获取第10-17个字节（8字节地址）
-                    dma_param.sctp.Destination_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.sctp.Destination_addr |= ((uint64_t)data[9 + i] << (i * 8));
-                    }
-                    // 传输长度，获取第18-21个字节（4字节长度）
-                    dma_param.sctp.Transfer_length = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.sctp.Transfer_length |= ((uint32_t)data[17 + i] << (i * 8));
-                    }
-                    
-                    break;
-                case 0x01:
-                    dma_param.mttp.trans_mode = trans_mode_flag;
-                    // 源地址，获取第2-9个字节（8字节地址）
-                    dma_param.mttp.Source_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.mttp.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
-                    }
-                    // 目的地址，获取第10-17个字节（8字节地址）
-                    dma_param.mttp.Destination_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.mttp.Destination_addr |= ((uint64_t)data[9 + i] << (i * 8));
-                    }
-                    // 行数，获取第18-21个字节（4字节行数）
-                    dma_param.mttp.Row_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.mttp.Row_num |= ((uint32_t)data[17 + i] << (i * 8));
-                    }
-                    // 列数，获取第22-25个字节（4字节列数）
-                    dma_param.mttp.Column_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.mttp.Column_num |= ((uint32_t)data[21 + i] << (i * 8));
-                    }
-                    // 元素字节数，获取第26-29个字节（4字节元素字节数）
-                    dma_param.mttp.element_byte_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.mttp.element_byte_num |= ((uint32_t)data[25 + i] << (i * 8));
-                    }
-                    // 是否为复数，获取第30个字节（1字节，0表示实数，1表示复数）
-                    dma_param.mttp.is_complex = data[29];
-                    break;
-                case 0x02:
-                    dma_param.sgtp.trans_mode = trans_mode_flag;
-                    // 目的地址，获取第2-9个字节（8字节地址）
-                    dma_param.sgtp.Destination_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.sgtp.Destination_addr |= ((uint64_t)data[1 + i] << (i * 8));
-                    }
-                    // 目标帧索引，获取第10-17个字节（8字节索引）
-                    dma_param.sgtp.Destination_array_index = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.sgtp.Destination_array_index |= ((uint64_t)data[9 + i] << (i * 8));
-                    }
-                    
-                    // 目标单元字节数，获取第18-21个字节（4字节计数）
-                    dma_param.sgtp.Destination_elem_Byte_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.sgtp.Destination_elem_Byte_num |= ((uint32_t)data[17 + i] << (i * 8));
-                    }
-                    
-                    // 目标帧数，获取第22-25个字节（4字节计数）
-                    dma_param.sgtp.Destination_array_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.sgtp.Destination_array_num |= ((uint32_t)data[21 + i] << (i * 8));
-                    }
-                    
-                    break;
-                case 0x03:
-                    dma_param.p2pt.trans_mode = trans_mode_flag;
-                    
-                    // 源地址，获取第2-9个字节（8字节地址）
-                    dma_param.p2pt.Source_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.p2pt.Source_addr |= ((uint64_t)data[1 + i] << (i * 8));
-                    }
-                    
-                    // 源帧索引，获取第10-17个字节（8字节索引）
-                    dma_param.p2pt.Source_array_index = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.p2pt.Source_array_index |= ((uint64_t)data[9 + i] << (i * 8));
-                    }
-                    
-                    // 源单元字节数，获取第18-21个字节（4字节计数）
-                    dma_param.p2pt.Source_elem_Byte_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.p2pt.Source_elem_Byte_num |= ((uint32_t)data[17 + i] << (i * 8));
-                    }
-                    
-                    // 源帧数，获取第22-25个字节（4字节计数）
-                    dma_param.p2pt.Source_array_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.p2pt.Source_array_num |= ((uint32_t)data[21 + i] << (i * 8));
-                    }
-                    
-                    // 目标地址，获取第26-33个字节（8字节地址）
-                    dma_param.p2pt.Destination_addr = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.p2pt.Destination_addr |= ((uint64_t)data[25 + i] << (i * 8));
-                    }
-                    
-                    // 目标帧索引，获取第34-41个字节（8字节索引）
-                    dma_param.p2pt.Destination_array_index = 0;
-                    for(int i = 0; i < 8; i++) {
-                        dma_param.p2pt.Destination_array_index |= ((uint64_t)data[33 + i] << (i * 8));
-                    }
-                    
-                    // 目标单元字节数，获取第42-45个字节（4字节计数）
-                    dma_param.p2pt.Destination_elem_Byte_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.p2pt.Destination_elem_Byte_num |= ((uint32_t)data[41 + i] << (i * 8));
-                    }
-                    
-                    // 目标帧数，获取第46-49个字节（4字节计数）
-                    dma_param.p2pt.Destination_array_num = 0;
-                    for(int i = 0; i < 4; i++) {
-                        dma_param.p2pt.Destination_array_num |= ((uint32_t)data[45 + i] << (i * 8));
-                    }
-                    break;
-                default:
-                    SC_REPORT_ERROR("DMA", "Unsupported transfer mode");
-                    sc_stop();
-                    break;
-            }
-            // 更新状态
-            dma_state = BUSY;
-            init_process_start_event.notify();
-        }
-        else{
-            SC_REPORT_ERROR("DMA", "DMA is busy");
-            sc_stop();
-        }
-        // sc_dt::uint64 address = trans.get_address();
-        // if(address >= SM_BASE_ADDR && address < SM_BASE_ADDR + SM_SIZE){
-        //     dma2sm_init_socket->b_transport(trans, delay);
-        // }else if(address >= AM_BASE_ADDR && address < AM_BASE_ADDR + AM_SIZE){
-        //     dma2am_init_socket->b_transport(trans, delay);
-        // }else{
-        //     SC_REPORT_ERROR("DMA", "Address out of range");
-        // }
+        return true;
     }
     //DMI请求方法
     virtual bool get_direct_mem_ptr(int id, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
@@ -791,35 +816,11 @@ public:
 
 private:
     bool dmi_ptr_valid;  // 标记 DMI 指针是否有效
-    //dma状态变量
-    enum DMA_STATE{
-        IDLE,
-        BUSY,
-        SG_READY,
-        ERROR
-    };
-
-    DMA_STATE dma_state = IDLE;
-    sc_time dma_delay = sc_time(0, SC_NS);
-    uint8_t trans_mode_flag;
-    //定义内部变量
-    tlm::tlm_generic_payload* dma_payload;
-    Trans_Param dma_param;
-        // 声明DMI对象
-    tlm::tlm_dmi dmi_data_read;
-    tlm::tlm_dmi dmi_data_write;
-    tlm::tlm_generic_payload dma_read_trans;
-    tlm::tlm_generic_payload dma_write_trans;
-    //事件通知变量
-    sc_event init_process_start_event;
-    sc_event simple_continuous_trans_event;
-    sc_event simple_continuous_trans_done_event;
-    sc_event matrix_transpose_transfer_event;
-    sc_event matrix_transpose_transfer_done_event;
-    sc_event sg_transfer_event;
-    sc_event sg_transfer_done_event;
-    sc_event point2point_transfer_event;
-    sc_event point2point_transfer_done_event;
+    DMA_Channel channels[DMA_CHANNEL_NUM];
+    //非阻塞(AT)接口状态：在途请求数、等待接纳的请求及接纳事件
+    uint32_t nb_outstanding = 0;
+    std::deque<DMA_Descriptor> nb_pending;
+    sc_event nb_admit_event;
 
     // Helper function to get DMI access
     bool get_dmi_access(tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data, uint64_t addr, const char* mem_name) {
@@ -38,7 +38,12 @@ public:
         }
         
         trans.set_response_status(tlm::TLM_OK_RESPONSE);
-        wait(SM_LATENCY);
+        //LT模式下只做延时标注，由initiator按量子统一同步
+        if (lt_mode_enabled()) {
+            delay += SM_LATENCY;
+        } else {
+            wait(SM_LATENCY);
+        }
     }
 
 private:
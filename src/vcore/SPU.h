@@ -20,6 +20,8 @@ public:
     {
         vcore2spu_target_socket.register_b_transport(this, &SPU::b_transport);
         vcore2spu_target_socket.register_get_direct_mem_ptr(this, &SPU::get_direct_mem_ptr);
+        vcore2spu_target_socket.register_nb_transport_fw(this, &SPU::nb_transport_fw);
+        spu2dma_init_socket.register_nb_transport_bw(this, &SPU::spu2dma_nb_transport_bw);
         spu2cac_init_socket.register_invalidate_direct_mem_ptr(this, &SPU::invalidate_direct_mem_ptr);
         spu2vpu_init_socket.register_invalidate_direct_mem_ptr(this, &SPU::invalidate_direct_mem_ptr);
         spu2dma_init_socket.register_invalidate_direct_mem_ptr(this, &SPU::invalidate_direct_mem_ptr);
@@ -53,6 +55,27 @@ public:
             return;
         }
     }
+    //非阻塞传输方法，目前只有DMA支持非阻塞(AT)接口
+    tlm::tlm_sync_enum nb_transport_fw(int id, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        sc_dt::uint64 address = trans.get_address();
+        if (address >= DMA_BASE_ADDR && address < DMA_BASE_ADDR + DMA_SIZE) {
+            if (phase == tlm::BEGIN_REQ) {
+                nb_route.record(&trans, id);
+            }
+            tlm::tlm_sync_enum status = spu2dma_init_socket->nb_transport_fw(trans, phase, delay);
+            nb_route.release(&trans, phase, status);
+            return status;
+        }
+        SC_REPORT_ERROR("SPU", "nb_transport_fw:Address not supported");
+        trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+        phase = tlm::END_RESP;
+        return tlm::TLM_COMPLETED;
+    }
+    tlm::tlm_sync_enum spu2dma_nb_transport_bw(int id, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        tlm::tlm_sync_enum status = vcore2spu_target_socket[nb_route.lookup(&trans)]->nb_transport_bw(trans, phase, delay);
+        nb_route.release(&trans, phase, status);
+        return status;
+    }
     //DMI请求方法
     bool get_direct_mem_ptr(int id, tlm::tlm_generic_payload& trans, tlm::tlm_dmi& dmi_data) {
         sc_dt::uint64 address = trans.get_address();
@@ -90,6 +113,8 @@ public:
 
 private:
     bool dmi_ptr_valid;  // 标记 DMI 指针是否有效
+    //非阻塞事务的反向路由表
+    nb_route_table nb_route;
 };
 
 #endif
@@ -16,6 +16,21 @@ SC_MODULE(Top){
 
 int sc_main(int argc, char* argv[])
 {
+    // ./main --lt 开启时间解耦(LT)模式，需在实例化模块之前设置
+    // ./main --real 以实数帧测试（两帧打包成一次复数FFT）
+    // ./main --conv 以快速卷积（重叠保留 FFT -> 乘频谱 -> IFFT）滤波每帧
+    // ./main --pipeline 开启跨帧流水（搬入/计算/写回三级并行）
+    for (int i = 1; i < argc; i++) {
+        if (string(argv[i]) == "--lt") {
+            enable_lt_mode(LT_GLOBAL_QUANTUM);
+        } else if (string(argv[i]) == "--real") {
+            fft_test_modes().real_input = true;
+        } else if (string(argv[i]) == "--conv") {
+            fft_test_modes().fast_convolution = true;
+        } else if (string(argv[i]) == "--pipeline") {
+            fft_test_modes().pipelined_frames = true;
+        }
+    }
     Top top("top");
     sc_start(sc_time(300,SC_NS));  // Run for 10 seconds or until sc_stop() is called sc_time(20000, SC_NS)
     return 0;
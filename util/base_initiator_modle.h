@@ -37,6 +37,8 @@ public:
     tlm::tlm_dmi ddr_dmi;   
     tlm::tlm_dmi gsm_dmi;
     sc_event blocked_computation_done_event;
+    //LT模式下本initiator的量子保持器，各进程消耗的延时先在本地累加
+    tlm_utils::tlm_quantumkeeper qk;
 
     int array_width;
     int array_height;
@@ -47,6 +49,8 @@ public:
         array_width(16),array_height(16) {
         socket.register_invalidate_direct_mem_ptr(this, &BaseInitiatorModel::invalidate_direct_mem_ptr);
         soc2ext_target_socket.register_b_transport(this, &BaseInitiatorModel::b_transport);
+        socket.register_nb_transport_bw(this, &BaseInitiatorModel::nb_transport_bw);
+        qk.reset();
     }
 
     void invalidate_direct_mem_ptr(int id, sc_dt::uint64 start_range, sc_dt::uint64 end_range) {
@@ -66,6 +70,16 @@ public:
         //补充接收GEMM结果就绪的trans
     }
 
+    /**
+     * @brief 非阻塞传输反向路径
+     * 
+     * 接收DMA的END_REQ(请求被接受)和BEGIN_RESP(传输完成)，
+     * 通过payload上的trans_done_extension唤醒等待的进程
+     */
+    tlm::tlm_sync_enum nb_transport_bw(int id, tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay) {
+        return handle_nb_transport_bw(trans, phase, delay);
+    }
+
     /**
      * @brief 设置DMI访问
      * 
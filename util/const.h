@@ -1,18 +1,26 @@
 #ifndef CONST_H
 #define CONST_H
 
+//DMA多通道工作进程使用sc_spawn动态创建
+#ifndef SC_INCLUDE_DYNAMIC_PROCESSES
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+#endif
 #include <systemc>
 #include "tlm.h"
 #include "tlm_utils/simple_target_socket.h"
 #include "tlm_utils/simple_initiator_socket.h"
 #include "tlm_utils/multi_passthrough_target_socket.h"
 #include "tlm_utils/multi_passthrough_initiator_socket.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
 #include <fstream>
 #include <sstream>
 #include <vector>
 #include <array>
+#include <deque>
+#include <map>
 #include <iomanip>
 #include <cmath>
+#include <sys/mman.h>
 using namespace sc_core;
 using namespace sc_dt;
 using namespace std;
@@ -57,6 +65,20 @@ const uint64_t SM_AM_DATA_WIDTH = 64;  //每拍传输的字节数
 //DMA configurations
 const uint64_t DMA_BASE_ADDR = 0x0100f0000;  // DMA base address,0f0000-0fffff
 const uint64_t DMA_SIZE = 63L * 1024 ;  // DMA size (63KB)
+const uint32_t DMA_CHANNEL_NUM = 4;              //DMA独立通道数
+const uint64_t DMA_CHANNEL_REG_SIZE = 0x1000;    //每个通道的命令寄存器窗口大小，通道n地址为DMA_BASE_ADDR + n*0x1000
+const uint32_t DMA_DESC_FIFO_DEPTH = 16;         //每个通道描述符FIFO深度，满时反压initiator
+const uint32_t DMA_TRANSPOSE_CACHE_BLOCK = 64;   //矩阵转置搬运的缓存分块边长(元素数)，只影响仿真主机性能
+const uint32_t DMA_MAX_OUTSTANDING = 8;         //非阻塞(AT)接口最多同时在途的请求数，超出时延迟END_REQ反压initiator
+const uint32_t DMA_CMD_MAX_BYTES = 64;           //DMA命令字节流的最大长度
+//SG传输配置区：通道n的首个配置块位于SG_CONFIG_ADDR + n*SG_CONFIG_SIZE，链接的后续配置块可放在SM任意位置
+const uint64_t SG_CONFIG_ADDR = 0x010020f00;
+const uint64_t SG_CONFIG_SIZE = 0x800;           //每个通道配置区2KB
+const uint64_t SG_DATA_NUM_MASK = 0xFFFF;        //控制字低16位为分散块数
+const uint64_t SG_PARAM_VALID_BIT = 0x10000;     //控制字第17位为有效位
+const uint64_t SG_PARAM_CHAIN_BIT = 0x20000;     //控制字第18位为链接位，置位时分散块列表后紧跟下一配置块地址
+const uint32_t SG_MAX_CHAIN_LEN = 4096;          //单条命令最多链接的配置块数
+const uint64_t SG_CHAIN_AREA_ADDR = 0x010023000; //SG链接配置块默认存放区，位于各通道配置区之后
 // MAC configurations,在VCore中，且不影响AM和SM的空间
 const uint64_t VPU_BASE_ADDR = 0x010100000;  // MAC base address,100000-10ffff
 const uint64_t VPU_REGISTER_SIZE = 64L * 64 ;  // 64个64位寄存器
@@ -79,6 +101,10 @@ const sc_time MAC_LATENCY = sc_time(18, SC_NS);
 const sc_time ADD_LATENCY = sc_time(2, SC_NS);
 const sc_time SUB_LATENCY = sc_time(2, SC_NS);
 
+//时间解耦(LT)模式：initiator在本地累加标注延时，超过全局量子才与仿真内核同步一次
+const bool LT_MODE_ENABLE = false;                    //默认关闭，可通过 ./main --lt 开启
+const sc_time LT_GLOBAL_QUANTUM = sc_time(1, SC_US);  //全局量子，总仿真时间误差不超过一个量子
+
 //GEMM分块参数
 const int cu_max = 64;
 const int k_gsm_max = 384;
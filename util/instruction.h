@@ -11,7 +11,8 @@ namespace ins{
     template<typename T>
     void read_from_dmi(uint64_t addr, std::vector<T>& values, 
                       const tlm::tlm_dmi& dmi, unsigned int data_num,
-                      const std::string& module_name = "DMI_Utils") {
+                      const std::string& module_name = "DMI_Utils",
+                      tlm_utils::tlm_quantumkeeper* qk = nullptr) {
         const unsigned int bytes_per_block = DDR_DATA_WIDTH;
         const unsigned int elements_per_block = bytes_per_block / sizeof(T);
 
@@ -28,9 +29,9 @@ namespace ins{
                     memcpy(&values[i], dmi_addr + i * sizeof(T), sizeof(T));
                 }
                 
-                wait(SYSTEM_CLOCK);
+                lt_consume(qk, SYSTEM_CLOCK);
             }
-            wait(dmi.get_read_latency());
+            lt_consume(qk, dmi.get_read_latency());
         } else {
             SC_REPORT_ERROR(module_name.c_str(), "DMI read failed: Address out of range");
         }
@@ -40,7 +41,8 @@ namespace ins{
     template<typename T>
     void write_to_dmi(uint64_t start_addr, uint64_t& end_addr, 
                      const std::vector<T>& values, const tlm::tlm_dmi& dmi, 
-                     unsigned int data_num, const std::string& module_name = "DMI_Utils") {
+                     unsigned int data_num, const std::string& module_name = "DMI_Utils",
+                     tlm_utils::tlm_quantumkeeper* qk = nullptr) {
         const unsigned int bytes_per_block = DDR_DATA_WIDTH;
         const unsigned int elements_per_block = bytes_per_block / sizeof(T);
 
@@ -63,17 +65,101 @@ namespace ins{
                     memcpy(dmi_addr + i * sizeof(T), &values[i], sizeof(T));
                 }
                 
-                wait(SYSTEM_CLOCK);
+                lt_consume(qk, SYSTEM_CLOCK);
             }
-            wait(dmi.get_write_latency());
+            lt_consume(qk, dmi.get_write_latency());
         } else {
             SC_REPORT_ERROR(module_name.c_str(), "DMI write failed: Address out of range");
         }
     }
 
+    //============ 批量DMI访问 ============
+    //DMI后备内存上的零拷贝视图，指针在DMI有效期内一直可用
+    template<typename T>
+    struct dmi_span {
+        T* ptr;
+        size_t len;
+
+        dmi_span() : ptr(nullptr), len(0) {}
+        dmi_span(T* p, size_t n) : ptr(p), len(n) {}
+
+        T* data() const { return ptr; }
+        size_t size() const { return len; }
+        bool empty() const { return len == 0; }
+        T* begin() const { return ptr; }
+        T* end() const { return ptr + len; }
+        T& operator[](size_t i) const { return ptr[i]; }
+    };
+
+    //经DMI搬运bytes字节的时间：每DDR_DATA_WIDTH字节一拍，外加一次DMI访问延时，
+    //与read_from_dmi/write_to_dmi逐块wait的总和相同
+    inline sc_time dmi_transfer_time(uint64_t bytes, const sc_time& latency) {
+        return SYSTEM_CLOCK * static_cast<double>((bytes + DDR_DATA_WIDTH - 1) / DDR_DATA_WIDTH) + latency;
+    }
+
+    //取addr开始data_num个T的DMI视图，越界时报错并返回空视图
+    template<typename T>
+    dmi_span<T> dmi_view(uint64_t addr, const tlm::tlm_dmi& dmi, unsigned int data_num,
+                         const std::string& module_name = "DMI_Utils") {
+        if (addr < dmi.get_start_address() || addr + static_cast<uint64_t>(data_num) * sizeof(T) - 1 > dmi.get_end_address()) {
+            SC_REPORT_ERROR(module_name.c_str(), "DMI view failed: Address out of range");
+            return dmi_span<T>();
+        }
+        return dmi_span<T>(reinterpret_cast<T*>(dmi.get_dmi_ptr() + (addr - dmi.get_start_address())), data_num);
+    }
+
+    //批量读：一次拷贝data_num个元素，返回标注延时，不做wait
+    template<typename T>
+    sc_time dmi_read_bulk(uint64_t addr, T* values, const tlm::tlm_dmi& dmi, unsigned int data_num,
+                          const std::string& module_name = "DMI_Utils") {
+        dmi_span<T> src = dmi_view<T>(addr, dmi, data_num, module_name);
+        if (src.empty()) {
+            return SC_ZERO_TIME;
+        }
+        memcpy(values, src.data(), static_cast<uint64_t>(data_num) * sizeof(T));
+        return dmi_transfer_time(static_cast<uint64_t>(data_num) * sizeof(T), dmi.get_read_latency());
+    }
+
+    //批量写：一次拷贝data_num个元素，返回标注延时，不做wait
+    template<typename T>
+    sc_time dmi_write_bulk(uint64_t addr, const T* values, const tlm::tlm_dmi& dmi, unsigned int data_num,
+                           const std::string& module_name = "DMI_Utils") {
+        dmi_span<T> dst = dmi_view<T>(addr, dmi, data_num, module_name);
+        if (dst.empty()) {
+            return SC_ZERO_TIME;
+        }
+        memcpy(dst.data(), values, static_cast<uint64_t>(data_num) * sizeof(T));
+        return dmi_transfer_time(static_cast<uint64_t>(data_num) * sizeof(T), dmi.get_write_latency());
+    }
+
+    //read_from_dmi的批量版本：一次拷贝，整段延时只消耗一次
+    template<typename T>
+    void read_from_dmi_bulk(uint64_t addr, std::vector<T>& values, 
+                            const tlm::tlm_dmi& dmi, unsigned int data_num,
+                            const std::string& module_name = "DMI_Utils",
+                            tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        values.resize(data_num);
+        lt_consume(qk, dmi_read_bulk(addr, values.data(), dmi, data_num, module_name));
+    }
+
+    //write_to_dmi的批量版本：一次拷贝，整段延时只消耗一次
+    template<typename T>
+    void write_to_dmi_bulk(uint64_t start_addr, uint64_t& end_addr, 
+                           const std::vector<T>& values, const tlm::tlm_dmi& dmi, 
+                           unsigned int data_num, const std::string& module_name = "DMI_Utils",
+                           tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        if (data_num != values.size()) {
+            SC_REPORT_ERROR(module_name.c_str(), "Mismatch between data_num and values size");
+            return;
+        }
+        end_addr = start_addr + data_num * sizeof(T) - 1;
+        lt_consume(qk, dmi_write_bulk(start_addr, values.data(), dmi, data_num, module_name));
+    }
+
     //AM 16路并行列访问
     template <typename T>
-    void am2vpu_16_trans(vector<T>& data_vector, tlm::tlm_dmi& am_dmi, uint64_t source_addr, uint64_t array_byte_index, uint64_t array_element_num, uint64_t array_num) {
+    void am2vpu_16_trans(vector<T>& data_vector, tlm::tlm_dmi& am_dmi, uint64_t source_addr, uint64_t array_byte_index, uint64_t array_element_num, uint64_t array_num,
+                         tlm_utils::tlm_quantumkeeper* qk = nullptr) {
         //判断source_addr是否在AM的DMI范围内
         if (source_addr < am_dmi.get_start_address() || source_addr > am_dmi.get_end_address()) {
             SC_REPORT_ERROR("AM2VPU16Trans", "Source address out of range");
@@ -134,19 +220,17 @@ namespace ins{
             }
         }
         //这里考虑的是，帧数很多，但是单帧数据量不大（resnet18）,不会占满带宽，因此可以一次性读取所有数据，采用这种方式来模拟延时
-        wait(SYSTEM_CLOCK);
+        lt_consume(qk, SYSTEM_CLOCK);
         //cout << "将AM中矩阵数据载入到VPU中" << endl;
     }
 
-    //SG传输启动增强版(带帧结构)
-    template <typename T>
-    void sg_trans_ext_inst(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, const tlm::tlm_dmi& sm_dmi,
+    //============ DMA命令字节编码(寄存器兼容接口) ============
+    //ins中的DMA指令改为通过dma_descriptor_extension直接传递参数，以下编码函数仅供
+    //仍按字节流写DMA命令寄存器的模型使用，缓冲区至少DMA_CMD_MAX_BYTES字节
+    //SG传输命令：1字节模式 + 8字节目标地址 + 8字节目标帧索引 + 4字节目标单元字节数 + 4字节目标帧数，共25字节
+    inline uint32_t encode_sg_cmd(unsigned char* data,
         uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num) {
         //设置传输模式
-        tlm::tlm_generic_payload trans;
-        // 创建数据缓冲区：1字节模式 + 8字节目标地址 + 8字节目标帧索引 + 4字节目标单元字节数 + 4字节目标帧数
-        unsigned char* data = new unsigned char[25];
-        //设置传输模式
         data[0] = 0x02;  // 0x02表示SG传输模式
         
         // 设置目标地址（第1-8字节）
@@ -168,74 +252,14 @@ namespace ins{
         for(int i = 0; i < 4; i++) {
             data[21 + i] = (destination_array_num >> (i * 8)) & 0xFF;
         }
-        
-        //设置TLM传输属性
-        trans.set_data_ptr(data);
-        trans.set_address(DMA_BASE_ADDR);
-        trans.set_data_length(25);  // 总长度25字节
-        trans.set_command(tlm::TLM_WRITE_COMMAND);
-        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-
-        //发送传输事务
-        sc_time delay = SC_ZERO_TIME;
-        socket->b_transport(trans, delay);
-        //cout << "SG传输指令已发送,等待完成" << endl;
-        //等待事务完成
-        wait_for_OK_response(trans);
-        //cout << "SG传输指令已完成 " << endl;
-        //清理数据指针
-        delete[] data;
+        return 25;
     }
 
-    //SG传输配置参数写入内存
-    template <typename T>
-    void sg_trans_param_write_inst(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, const tlm::tlm_dmi& sm_dmi,
-        uint64_t source_addr, vector<uint32_t> Byte_index_list, vector<uint32_t> length_list, uint32_t data_num) {
-        // 为SG传输配置参数写入内存,默认写入SM中，从0x010020f00开始,不超过2KB大小
-        uint64_t start_addr = 0x010020f00;
-        // 检查DMI访问权限
-        if (!sm_dmi.is_write_allowed()) {
-            SC_REPORT_ERROR("Sg_trans_inst", "DMI write not allowed");
-            return;
-        }
-        // 检查地址范围
-        if (start_addr < sm_dmi.get_start_address() || 
-            start_addr + (data_num+2) *8  > sm_dmi.get_end_address()) {
-            //第一个双字（8B）位置存储配置状态标志，第二个双字位置存储源地址，其余位置配置sg参数
-            SC_REPORT_ERROR("Sg_trans_inst", "DMI address out of range");
-            return;
-        }
-        //sg传输控制参数字uint64_t类型，低8位为分散读取的次数即data_num，第9位为sg参数有效位，1代表有效，0代表无效
-        const uint64_t SG_PARAM_VALID_BIT = 0x10000;  // 第17位为1，表示有效
-        const uint64_t DATA_NUM_MASK = 0xFFFF;        // 低16位掩码
-        uint64_t sg_param = (data_num & DATA_NUM_MASK) | SG_PARAM_VALID_BIT;
-        // 获取DMI指针并计算偏移
-        unsigned char* sm_dmi_ptr = sm_dmi.get_dmi_ptr();
-        uint64_t offset = start_addr - sm_dmi.get_start_address();
-
-        // 写入内存
-        uint64_t* target = reinterpret_cast<uint64_t*>(sm_dmi_ptr + offset);
-        target[0] = sg_param;
-        target[1] = source_addr;
-
-        for (unsigned int i = 0; i < data_num; i++) {
-            target[i+2] = ((static_cast<uint64_t>(Byte_index_list[i]) << 32) | length_list[i]);
-        }
-
-        // cout << "SG配置参数通过DMI写入完成:写入" << dec << (data_num+2)*8 << "字节数据到地址0x" 
-        //     << hex << start_addr << dec << endl;
-    }
-
-
-    template <typename T>
-    void dma_matrix_transpose_trans(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, uint64_t source_addr, uint64_t destination_addr, 
-        uint32_t row_num, uint32_t column_num, uint32_t element_byte_num, bool is_complex = false) {
-        // 设置事务类型为DMA矩阵转置传输
-        tlm::tlm_generic_payload trans;
-        unsigned char* data = new unsigned char[30];
-
+    //矩阵转置传输命令：1字节模式 + 8字节源地址 + 8字节目标地址 + 4字节行数 + 4字节列数 + 4字节元素字节数 + 1字节复数标志，共30字节
+    inline uint32_t encode_transpose_cmd(unsigned char* data, uint64_t source_addr, uint64_t destination_addr, 
+        uint32_t row_num, uint32_t column_num, uint32_t element_byte_num, bool is_complex) {
         // 设置传输模式（第0字节）
-        data[0] = 0x01;  // 假设0x01表示矩阵转置传输模式
+        data[0] = 0x01;  // 0x01表示矩阵转置传输模式
         
         // 设置源地址（第1-8字节）
         for(int i = 0; i < 8; i++) {
@@ -259,38 +283,14 @@ namespace ins{
         }
         //设置是否为复数（第29字节）
         data[29] = is_complex;
-        // 设置TLM传输属性
-        trans.set_data_ptr(data);
-        trans.set_address(DMA_BASE_ADDR);
-        trans.set_data_length(30);  // 总长度30字节
-        trans.set_command(tlm::TLM_WRITE_COMMAND);  // 设置为写命令
-        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);  // 初始化响应状态
-
-        // 发送传输事务
-        sc_time delay = SC_ZERO_TIME;
-        socket->b_transport(trans, delay);
-        //等待事务完成
-        wait_for_OK_response(trans);
-        // 清理数据指针
-        delete[] data;
-        cout << "DMA矩阵转置传输完成,从地址0x" << hex << source_addr << "到地址0x" << destination_addr << "传输了" << dec << row_num << "行" << column_num << "列" << "单数据字节数："<< element_byte_num  << endl;
+        return 30;
     }
 
-    //DMA点对点传输
-    template <typename T>
-    void dma_p2p_trans(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket,
+    //点对点传输命令：1(模式) + 8(源地址) + 8(源帧索引) + 4(源单元字节数) + 4(源帧数)
+    // + 8(目标地址) + 8(目标帧索引) + 4(目标单元字节数) + 4(目标帧数)，共49字节
+    inline uint32_t encode_p2p_cmd(unsigned char* data,
         uint64_t source_addr, uint64_t source_array_index, uint32_t source_elem_byte_num, uint32_t source_array_num,
         uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num) {
-        
-        // 设置事务类型为DMA点对点传输
-        tlm::tlm_generic_payload trans;
-        
-        // 计算数据缓冲区大小：1字节传输模式 + 所有参数字节
-        // 1(模式) + 8(源地址) + 8(源帧索引) + 4(源单元字节数) + 4(源帧数)
-        // + 8(目标地址) + 8(目标帧索引) + 4(目标单元字节数) + 4(目标帧数)
-        // = 总共49字节
-        unsigned char* data = new unsigned char[49];
-        
         // 设置传输模式（第0字节）
         data[0] = 0x03;  // 0x03表示点对点传输模式
         
@@ -335,28 +335,243 @@ namespace ins{
         for(int i = 0; i < 4; i++) {
             data[45 + i] = (destination_array_num >> (i * 8)) & 0xFF;
         }
-        
-        // 设置TLM传输属性
-        trans.set_data_ptr(data);
-        trans.set_address(DMA_BASE_ADDR);
-        trans.set_data_length(49);  // 总长度49字节
+        return 49;
+    }
+
+    //============ 非阻塞(AT)DMA传输 ============
+    //非阻塞DMA传输句柄：从DMA命令payload池取一个payload，命令参数直接写入其描述符扩展，
+    //发起后到dma_nb_wait返回前必须保持有效，析构时payload归还池中
+    struct dma_nb_handle {
+        tlm::tlm_generic_payload* trans;
+        dma_descriptor_extension* desc_ext;
+        trans_done_extension* done_ext;
+
+        dma_nb_handle() : trans(dma_trans_pool().allocate()), desc_ext(nullptr), done_ext(nullptr) {
+            trans->acquire();
+            trans->get_extension(desc_ext);
+            trans->get_extension(done_ext);
+        }
+        dma_nb_handle(const dma_nb_handle&) = delete;
+        dma_nb_handle& operator=(const dma_nb_handle&) = delete;
+        ~dma_nb_handle() {
+            trans->release();
+        }
+    };
+
+    //以BEGIN_REQ发起句柄中已填好的命令；DMA在途请求已满时等待END_REQ，即请求被接受后返回
+    template <typename T>
+    void dma_nb_issue(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, dma_nb_handle& handle,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        //LT模式下，发起DMA之前先同步本地时间
+        lt_sync(qk);
+        tlm::tlm_generic_payload& trans = *handle.trans;
+        //命令参数在描述符扩展中，payload不带数据
+        trans.set_data_ptr(nullptr);
+        trans.set_data_length(0);
+        trans.set_address(DMA_BASE_ADDR + channel * DMA_CHANNEL_REG_SIZE);  // 按通道号选择DMA通道
         trans.set_command(tlm::TLM_WRITE_COMMAND);
         trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
-        
-        // 发送传输事务
+        //END_REQ和完成都通过完成扩展中的事件通知
+        handle.done_ext->end_req = false;
+
+        tlm::tlm_phase phase = tlm::BEGIN_REQ;
         sc_time delay = SC_ZERO_TIME;
-        socket->b_transport(trans, delay);
-        
+        tlm::tlm_sync_enum status = socket->nb_transport_fw(trans, phase, delay);
+        if (status == tlm::TLM_COMPLETED || (status == tlm::TLM_UPDATED && phase == tlm::END_REQ)) {
+            handle.done_ext->end_req = true;
+        }
+        while (!handle.done_ext->end_req) {
+            wait(handle.done_ext->end_req_event);
+        }
+    }
+
+    //等待非阻塞DMA传输完成，成功返回true
+    inline bool dma_nb_wait(dma_nb_handle& handle) {
+        return wait_for_OK_response(*handle.trans);
+    }
+
+    //非阻塞SG传输
+    template <typename T>
+    void sg_trans_ext_inst_nb(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, dma_nb_handle& handle,
+        uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        SG_Trans_Param& sgtp = handle.desc_ext->param.sgtp;
+        handle.desc_ext->trans_mode = sgtp.trans_mode = 0x02;  // 0x02表示SG传输模式
+        sgtp.Destination_addr = destination_addr;
+        sgtp.Destination_array_index = destination_array_index;
+        sgtp.Destination_elem_Byte_num = destination_elem_byte_num;
+        sgtp.Destination_array_num = destination_array_num;
+        dma_nb_issue(socket, handle, channel, qk);
+    }
+
+    //非阻塞矩阵转置传输
+    template <typename T>
+    void dma_matrix_transpose_trans_nb(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, dma_nb_handle& handle,
+        uint64_t source_addr, uint64_t destination_addr, 
+        uint32_t row_num, uint32_t column_num, uint32_t element_byte_num, bool is_complex = false,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        Matrix_Transpose_Trans_Param& mttp = handle.desc_ext->param.mttp;
+        handle.desc_ext->trans_mode = mttp.trans_mode = 0x01;  // 0x01表示矩阵转置传输模式
+        mttp.Source_addr = source_addr;
+        mttp.Destination_addr = destination_addr;
+        mttp.Row_num = row_num;
+        mttp.Column_num = column_num;
+        mttp.element_byte_num = element_byte_num;
+        mttp.is_complex = is_complex;
+        dma_nb_issue(socket, handle, channel, qk);
+    }
+
+    //非阻塞点对点传输
+    template <typename T>
+    void dma_p2p_trans_nb(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, dma_nb_handle& handle,
+        uint64_t source_addr, uint64_t source_array_index, uint32_t source_elem_byte_num, uint32_t source_array_num,
+        uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        Point2Point_Trans_Param& p2pt = handle.desc_ext->param.p2pt;
+        handle.desc_ext->trans_mode = p2pt.trans_mode = 0x03;  // 0x03表示点对点传输模式
+        p2pt.Source_addr = source_addr;
+        p2pt.Source_array_index = source_array_index;
+        p2pt.Source_elem_Byte_num = source_elem_byte_num;
+        p2pt.Source_array_num = source_array_num;
+        p2pt.Destination_addr = destination_addr;
+        p2pt.Destination_array_index = destination_array_index;
+        p2pt.Destination_elem_Byte_num = destination_elem_byte_num;
+        p2pt.Destination_array_num = destination_array_num;
+        dma_nb_issue(socket, handle, channel, qk);
+    }
+
+    //============ 阻塞DMA传输(非阻塞接口的封装) ============
+    //SG传输启动增强版(带帧结构)
+    template <typename T>
+    void sg_trans_ext_inst(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, const tlm::tlm_dmi& sm_dmi,
+        uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        dma_nb_handle handle;
+        sg_trans_ext_inst_nb(socket, handle, destination_addr, destination_array_index, destination_elem_byte_num, destination_array_num,
+                             channel, qk);
+        //cout << "SG传输指令已发送,等待完成" << endl;
+        //等待事务完成
+        dma_nb_wait(handle);
+        //cout << "SG传输指令已完成 " << endl;
+    }
+
+    //SG传输配置参数写入内存
+    //config_addr为配置块地址，默认是通道0的配置区；next_config_addr非0时置链接位并在列表后写入下一配置块地址
+    template <typename T>
+    void sg_trans_param_write_inst(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, const tlm::tlm_dmi& sm_dmi,
+        uint64_t source_addr, vector<uint32_t> Byte_index_list, vector<uint32_t> length_list, uint32_t data_num,
+        uint64_t config_addr = SG_CONFIG_ADDR, uint64_t next_config_addr = 0) {
+        // 为SG传输配置参数写入内存,默认写入SM中，从0x010020f00开始,不超过2KB大小
+        uint64_t start_addr = config_addr;
+        uint32_t word_num = data_num + 2 + (next_config_addr != 0 ? 1 : 0);
+        // 检查DMI访问权限
+        if (!sm_dmi.is_write_allowed()) {
+            SC_REPORT_ERROR("Sg_trans_inst", "DMI write not allowed");
+            return;
+        }
+        // 检查地址范围
+        if (start_addr < sm_dmi.get_start_address() || 
+            start_addr + word_num * 8  > sm_dmi.get_end_address()) {
+            //第一个双字（8B）位置存储配置状态标志，第二个双字位置存储源地址，其余位置配置sg参数
+            SC_REPORT_ERROR("Sg_trans_inst", "DMI address out of range");
+            return;
+        }
+        //sg传输控制参数字uint64_t类型，低16位为分散读取的次数即data_num，第17位为sg参数有效位，第18位为链接位
+        uint64_t sg_param = (data_num & SG_DATA_NUM_MASK) | SG_PARAM_VALID_BIT;
+        if (next_config_addr != 0) {
+            sg_param |= SG_PARAM_CHAIN_BIT;
+        }
+        // 获取DMI指针并计算偏移
+        unsigned char* sm_dmi_ptr = sm_dmi.get_dmi_ptr();
+        uint64_t offset = start_addr - sm_dmi.get_start_address();
+
+        // 写入内存
+        uint64_t* target = reinterpret_cast<uint64_t*>(sm_dmi_ptr + offset);
+        target[0] = sg_param;
+        target[1] = source_addr;
+
+        for (unsigned int i = 0; i < data_num; i++) {
+            target[i+2] = ((static_cast<uint64_t>(Byte_index_list[i]) << 32) | length_list[i]);
+        }
+        if (next_config_addr != 0) {
+            target[data_num+2] = next_config_addr;
+        }
+
+        // cout << "SG配置参数通过DMI写入完成:写入" << dec << (data_num+2)*8 << "字节数据到地址0x" 
+        //     << hex << start_addr << dec << endl;
+    }
+
+    //SG链式配置写入：分散块数超过一个配置区容量时自动拆成多个配置块并链接，
+    //首块写入通道channel的配置区，后续块依次写入SM中的SG_CHAIN_AREA_ADDR开始的链接区
+    template <typename T>
+    void sg_trans_chain_param_write_inst(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, const tlm::tlm_dmi& sm_dmi,
+        uint64_t source_addr, const vector<uint32_t>& Byte_index_list, const vector<uint32_t>& length_list,
+        uint32_t channel = 0, uint64_t chain_area_addr = SG_CHAIN_AREA_ADDR) {
+        //每个配置块：控制字 + 源地址 + 分散块列表 + 下一块地址
+        const uint32_t entries_per_block = std::min<uint64_t>(SG_CONFIG_SIZE / 8 - 3, SG_DATA_NUM_MASK);
+        uint32_t total_num = Byte_index_list.size();
+        uint64_t config_addr = SG_CONFIG_ADDR + channel * SG_CONFIG_SIZE;
+        uint64_t next_addr = chain_area_addr;
+        for (uint32_t first = 0; first < total_num || first == 0; first += entries_per_block) {
+            uint32_t num = std::min(entries_per_block, total_num - first);
+            bool last = (first + num >= total_num);
+            vector<uint32_t> index_block(Byte_index_list.begin() + first, Byte_index_list.begin() + first + num);
+            vector<uint32_t> length_block(length_list.begin() + first, length_list.begin() + first + num);
+            sg_trans_param_write_inst(socket, sm_dmi, source_addr, index_block, length_block, num,
+                                      config_addr, last ? 0 : next_addr);
+            if (last) {
+                break;
+            }
+            config_addr = next_addr;
+            next_addr += SG_CONFIG_SIZE;
+        }
+    }
+
+
+    template <typename T>
+    void dma_matrix_transpose_trans(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, uint64_t source_addr, uint64_t destination_addr, 
+        uint32_t row_num, uint32_t column_num, uint32_t element_byte_num, bool is_complex = false,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        dma_nb_handle handle;
+        dma_matrix_transpose_trans_nb(socket, handle, source_addr, destination_addr, row_num, column_num, element_byte_num, is_complex,
+                                      channel, qk);
+        //等待事务完成
+        dma_nb_wait(handle);
+        cout << "DMA矩阵转置传输完成,从地址0x" << hex << source_addr << "到地址0x" << destination_addr << "传输了" << dec << row_num << "行" << column_num << "列" << "单数据字节数："<< element_byte_num  << endl;
+    }
+
+    //DMA点对点传输
+    template <typename T>
+    void dma_p2p_trans(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket,
+        uint64_t source_addr, uint64_t source_array_index, uint32_t source_elem_byte_num, uint32_t source_array_num,
+        uint64_t destination_addr, uint64_t destination_array_index, uint32_t destination_elem_byte_num, uint32_t destination_array_num,
+        uint32_t channel = 0, tlm_utils::tlm_quantumkeeper* qk = nullptr) {
+        dma_nb_handle handle;
+        dma_p2p_trans_nb(socket, handle, source_addr, source_array_index, source_elem_byte_num, source_array_num,
+                         destination_addr, destination_array_index, destination_elem_byte_num, destination_array_num,
+                         channel, qk);
         // 等待事务完成
-        wait_for_OK_response(trans);
-        
-        // 清理数据指针
-        delete[] data;
+        dma_nb_wait(handle);
         
         cout << "DMA点对点传输完成，从地址0x" << hex << source_addr << "到地址0x" << destination_addr 
              << "，源帧数:" << dec << source_array_num << "，目标帧数:" << destination_array_num << endl;
     }
 
+    //读取DMA通道状态字：[7:0]通道状态(0空闲/1忙/3出错)，[15:8]FIFO中等待的描述符数，[63:32]已完成描述符数
+    template <typename T>
+    uint64_t dma_channel_status(tlm_utils::multi_passthrough_initiator_socket<T,512>& socket, uint32_t channel = 0) {
+        tlm::tlm_generic_payload trans;
+        uint64_t status = 0;
+        trans.set_data_ptr(reinterpret_cast<unsigned char*>(&status));
+        trans.set_address(DMA_BASE_ADDR + channel * DMA_CHANNEL_REG_SIZE);
+        trans.set_data_length(sizeof(status));
+        trans.set_command(tlm::TLM_READ_COMMAND);
+        trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+        sc_time delay = SC_ZERO_TIME;
+        socket->b_transport(trans, delay);
+        return status;
+    }
+
    
 
 }
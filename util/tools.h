@@ -83,6 +83,17 @@ vector<complex<T>> calculate_twiddle_factors(uint32_t point_num) {
     return W_N;
 }
 
+//按点数缓存的硬件旋转因子表，同一点数只计算一次，多帧、多级分解共用
+template <typename T>
+const vector<complex<T>>& cached_twiddle_factors(uint32_t point_num) {
+    static std::map<uint32_t, vector<complex<T>>> tables;
+    auto it = tables.find(point_num);
+    if (it == tables.end()) {
+        it = tables.emplace(point_num, calculate_twiddle_factors<T>(point_num)).first;
+    }
+    return it->second;
+}
+
 // 平均池化函数: 对三维输入特征图执行平均池化操作
 // 参数:
 //   output_data - 输出数据数组 (一维表示的三维数据)
@@ -188,10 +199,11 @@ vector<complex<T>> calculate_twiddle_factors_ifft(uint32_t point_num) {
 template <typename T>
 vector<complex<T>> calculate_rotation_factors_compensate(uint32_t N1, uint32_t N2) {
     vector<complex<T>> rotation_factors(N1 * N2);
-    T N = static_cast<T>(N1 * N2);
+    //角度用double计算，避免大点数时float角度的精度损失
+    double N = static_cast<double>(N1) * N2;
     for (uint32_t k1 = 0; k1 < N1; ++k1) {
         for (uint32_t k2 = 0; k2 < N2; ++k2) {
-            T angle = -2.0 * M_PI * k1 * k2 / N;
+            double angle = -2.0 * M_PI * k1 * k2 / N;
             complex<T> w;
             w.real = cos(angle);
             w.imag = sin(angle);
@@ -231,9 +243,256 @@ inline void calculate_reverse_index(vector<uint32_t>& output_index_list, uint32_
     }
 }
 
-inline void wait_for_OK_response(tlm::tlm_generic_payload& trans){
-    while(trans.get_response_status() != tlm::TLM_OK_RESPONSE){
-        wait(SYSTEM_CLOCK);
+//传输完成通知扩展：initiator挂在payload上，target(DMA)完成后触发done_event，
+//initiator直接睡眠到完成时刻，不再逐周期轮询响应状态
+struct trans_done_extension : public tlm::tlm_extension<trans_done_extension> {
+    sc_event done_event;
+    //非阻塞(AT)传输：target是否已接受请求(END_REQ)，未接受时initiator等待end_req_event
+    bool end_req;
+    sc_event end_req_event;
+
+    trans_done_extension() : end_req(false) {}
+
+    //sc_event不可拷贝，克隆出的扩展只带一个新的事件
+    virtual tlm::tlm_extension_base* clone() const {
+        return new trans_done_extension();
+    }
+
+    virtual void copy_from(tlm::tlm_extension_base const& ext) {
+    }
+};
+
+//target端：设置响应状态，并通过完成扩展唤醒等待的initiator
+inline void notify_trans_done(tlm::tlm_generic_payload& trans, tlm::tlm_response_status status = tlm::TLM_OK_RESPONSE){
+    trans.set_response_status(status);
+    trans_done_extension* done_ext = nullptr;
+    trans.get_extension(done_ext);
+    if(done_ext != nullptr){
+        done_ext->done_event.notify(SC_ZERO_TIME);
+    }
+}
+
+//initiator端：有完成扩展时等待完成事件，否则退回逐周期轮询；
+//target以错误响应结束时报告错误并返回false
+inline bool wait_for_OK_response(tlm::tlm_generic_payload& trans){
+    trans_done_extension* done_ext = nullptr;
+    trans.get_extension(done_ext);
+    while(trans.get_response_status() == tlm::TLM_INCOMPLETE_RESPONSE){
+        if(done_ext != nullptr){
+            wait(done_ext->done_event);
+        }else{
+            wait(SYSTEM_CLOCK);
+        }
+    }
+    if(trans.get_response_status() != tlm::TLM_OK_RESPONSE){
+        SC_REPORT_ERROR("wait_for_OK_response", trans.get_response_string().c_str());
+        return false;
+    }
+    return true;
+}
+
+//============ DMA命令描述符 ============
+//简单连续传输参数结构体
+struct Simple_Continuous_Trans_Param{
+    uint8_t trans_mode;           //传输模式,0:简单连续传输，
+    uint64_t Source_addr;         //源开始地址
+    uint64_t Destination_addr;    //目的开始地址
+    uint32_t Transfer_length;     //传输长度,单位字节，最大为1GB(0x4000 0000)，最小为1字节
+};
+//点对点传输参数结构体
+struct Point2Point_Trans_Param{
+    uint8_t trans_mode;           //传输模式,3:点对点传输
+    uint64_t Source_addr;         //源开始地址
+    uint64_t Source_array_index;          //源帧索引
+    uint32_t Source_elem_Byte_num;      //源单元计数
+    uint32_t Source_array_num;          //源帧计数
+    uint64_t Destination_addr;          //目的开始地址
+    uint64_t Destination_array_index;          //目的帧索引
+    uint32_t Destination_elem_Byte_num;      //目的单元计数
+    uint32_t Destination_array_num;          //目的帧计数
+
+};
+//矩阵转置传输参数结构体
+struct Matrix_Transpose_Trans_Param{
+    uint8_t trans_mode;           //传输模式,1:矩阵转置传输，
+    uint64_t Source_addr;         //源开始地址
+    uint64_t Destination_addr;    //目的开始地址
+    uint32_t Row_num;             //行数
+    uint32_t Column_num;          //列数
+    uint32_t element_byte_num;    //元素字节数
+    bool is_complex;                //是否为复数，默认不为复数
+};
+//SG传输参数结构体
+struct SG_Trans_Param{
+    uint8_t trans_mode;           //传输模式,2:SG传输
+    uint64_t Destination_addr;    //目的开始地址
+    uint64_t Destination_array_index;          //目的帧索引
+    uint32_t Destination_elem_Byte_num;      //目的单元计数
+    uint32_t Destination_array_num;          //目的帧计数
+};
+
+union Trans_Param{
+    Simple_Continuous_Trans_Param sctp;
+    Matrix_Transpose_Trans_Param mttp;
+    SG_Trans_Param sgtp;
+    Point2Point_Trans_Param p2pt;
+};
+
+//DMA命令描述符扩展：initiator直接把类型化的传输参数挂在payload上交给DMA，
+//省去命令字节流的逐字节编码/解码；不带此扩展的payload仍按字节命令解码(兼容接口)
+struct dma_descriptor_extension : public tlm::tlm_extension<dma_descriptor_extension> {
+    uint8_t trans_mode;
+    Trans_Param param;
+
+    dma_descriptor_extension() : trans_mode(0) {
+        memset(&param, 0, sizeof(param));
+    }
+
+    virtual tlm::tlm_extension_base* clone() const {
+        dma_descriptor_extension* ext = new dma_descriptor_extension();
+        ext->copy_from(*this);
+        return ext;
+    }
+
+    virtual void copy_from(tlm::tlm_extension_base const& ext) {
+        const dma_descriptor_extension& other = static_cast<const dma_descriptor_extension&>(ext);
+        trans_mode = other.trans_mode;
+        param = other.param;
+    }
+};
+
+//DMA命令payload池(tlm_mm)：payload用完后由release()归还池中循环使用，
+//每个payload常驻挂载描述符扩展和完成扩展，发起命令时不再有任何堆分配
+class dma_payload_pool : public tlm::tlm_mm_interface {
+public:
+    ~dma_payload_pool() {
+        for (tlm::tlm_generic_payload* trans : all_payloads) {
+            delete trans;   //payload析构时一并释放挂载的扩展
+        }
+    }
+
+    tlm::tlm_generic_payload* allocate() {
+        if (free_payloads.empty()) {
+            tlm::tlm_generic_payload* trans = new tlm::tlm_generic_payload(this);
+            trans->set_extension(new dma_descriptor_extension());
+            trans->set_extension(new trans_done_extension());
+            all_payloads.push_back(trans);
+            return trans;
+        }
+        tlm::tlm_generic_payload* trans = free_payloads.back();
+        free_payloads.pop_back();
+        return trans;
+    }
+
+    //引用计数归零时由payload回调，扩展保留在payload上
+    virtual void free(tlm::tlm_generic_payload* trans) {
+        free_payloads.push_back(trans);
+    }
+
+private:
+    std::vector<tlm::tlm_generic_payload*> all_payloads;
+    std::vector<tlm::tlm_generic_payload*> free_payloads;
+};
+
+//全局DMA命令payload池
+inline dma_payload_pool& dma_trans_pool() {
+    static dma_payload_pool pool;
+    return pool;
+}
+
+//============ 非阻塞(AT)传输 ============
+//initiator端nb_transport_bw的通用处理：END_REQ表示请求被target接受，BEGIN_RESP表示传输完成，
+//立即以TLM_COMPLETED结束响应阶段
+inline tlm::tlm_sync_enum handle_nb_transport_bw(tlm::tlm_generic_payload& trans, tlm::tlm_phase& phase, sc_time& delay){
+    trans_done_extension* done_ext = nullptr;
+    trans.get_extension(done_ext);
+    if(phase == tlm::END_REQ){
+        if(done_ext != nullptr){
+            done_ext->end_req = true;
+            done_ext->end_req_event.notify(delay);
+        }
+        return tlm::TLM_ACCEPTED;
+    }
+    if(phase == tlm::BEGIN_RESP){
+        if(done_ext != nullptr){
+            done_ext->end_req = true;
+            done_ext->end_req_event.notify(delay);
+            done_ext->done_event.notify(delay);
+        }
+        phase = tlm::END_RESP;
+        return tlm::TLM_COMPLETED;
+    }
+    SC_REPORT_ERROR("nb_transport_bw", "Unexpected phase");
+    return tlm::TLM_COMPLETED;
+}
+
+//互连模块转发非阻塞事务时记录payload来自哪个target socket编号，供反向路径查找
+class nb_route_table {
+public:
+    void record(tlm::tlm_generic_payload* trans, int id) {
+        route[trans] = id;
+    }
+    int lookup(tlm::tlm_generic_payload* trans) const {
+        auto it = route.find(trans);
+        return it == route.end() ? 0 : it->second;
+    }
+    //事务结束(END_RESP或TLM_COMPLETED)后删除记录
+    void release(tlm::tlm_generic_payload* trans, tlm::tlm_phase phase, tlm::tlm_sync_enum status) {
+        if (status == tlm::TLM_COMPLETED || phase == tlm::END_RESP) {
+            route.erase(trans);
+        }
+    }
+private:
+    std::map<tlm::tlm_generic_payload*, int> route;
+};
+
+//============ 时间解耦(LT)模式 ============
+//LT模式运行时开关，默认取LT_MODE_ENABLE
+inline bool& lt_mode_flag() {
+    static bool flag = LT_MODE_ENABLE;
+    return flag;
+}
+inline bool lt_mode_enabled() {
+    return lt_mode_flag();
+}
+//开启LT模式并设置全局量子，需在实例化各模块之前调用
+inline void enable_lt_mode(const sc_time& quantum = LT_GLOBAL_QUANTUM) {
+    lt_mode_flag() = true;
+    tlm_utils::tlm_quantumkeeper::set_global_quantum(quantum);
+}
+//消耗一段延时：LT模式下累加到量子保持器，超出量子才同步；否则直接wait
+inline void lt_consume(tlm_utils::tlm_quantumkeeper* qk, const sc_time& t) {
+    if (qk != nullptr && lt_mode_enabled()) {
+        qk->inc(t);
+        if (qk->need_sync()) {
+            qk->sync();
+        }
+    } else {
+        wait(t);
+    }
+}
+//与其他进程交互(发事务、通知事件)前，把本地累加的时间同步到仿真内核
+inline void lt_sync(tlm_utils::tlm_quantumkeeper* qk) {
+    if (qk != nullptr && lt_mode_enabled() && qk->get_local_time() > SC_ZERO_TIME) {
+        qk->sync();
+    }
+}
+
+//============ 大容量存储的稀疏后备内存 ============
+//匿名mmap映射：只保留虚拟地址空间，页面首次访问时才由内核分配并清零，
+//未访问的区域不占物理内存，无需逐元素初始化
+inline unsigned char* alloc_sparse_memory(uint64_t size, const char* module_name = "Memory") {
+    void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (ptr == MAP_FAILED) {
+        SC_REPORT_ERROR(module_name, "mmap of backing store failed");
+        return nullptr;
+    }
+    return static_cast<unsigned char*>(ptr);
+}
+inline void free_sparse_memory(unsigned char* ptr, uint64_t size) {
+    if (ptr != nullptr) {
+        munmap(ptr, size);
     }
 }
 